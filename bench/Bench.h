@@ -0,0 +1,32 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+/// @brief Timing helpers shared by the benchmarks
+namespace Bench
+{
+	inline volatile std::uint64_t sink = 0;
+
+	/// @brief Keep a result alive, so the optimizer cannot drop the work which produced it
+	inline void Consume(std::uint64_t a_value) { sink = sink ^ a_value; }
+
+	/// @brief Call a_fn a_iterations times after a short warmup and print the mean time per call
+	/// @return nanoseconds per call
+	template <class F>
+	double Run(const char* a_name, std::size_t a_iterations, F&& a_fn)
+	{
+		for (std::size_t i = 0; i < a_iterations / 10 + 1; i++) {
+			a_fn();
+		}
+		const auto start = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < a_iterations; i++) {
+			a_fn();
+		}
+		const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		const auto perCall = elapsed.count() / static_cast<double>(a_iterations);
+		std::printf("%-48s %12.1f ns/op\n", a_name, perCall);
+		return perCall;
+	}
+}
@@ -0,0 +1,139 @@
+// Evaluation throughput on long condition chains: the linked condition items walked before against the compiled program
+// Every condition is a native one, so no game function is called. Items are dispatched the same way engine functions are
+#include <random>
+
+#include "Bench.h"
+
+#include "Dialogue/Conditions/Conditional.h"
+
+namespace
+{
+	constexpr std::size_t CHAINS = 1'000;
+	constexpr std::size_t GROUPS = 8;
+	constexpr std::size_t GROUP_SIZE = 4;
+	constexpr std::size_t CHAIN_LENGTH = GROUPS * GROUP_SIZE;
+
+	/// @brief Values returned by the registered natives, the user pointer selects one. The comparands decide which conditions hold
+	std::array<float, GROUP_SIZE> values{ 1.0f, 1.0f, 1.0f, 1.0f };
+
+	float Native(void* a_user, void*, void*)
+	{
+		return *static_cast<const float*>(a_user);
+	}
+
+	/// @brief Stand-in for a linked RE::TESConditionItem, with the fields the old walk read and the size of the real one
+	struct Node
+	{
+		Node* next;
+		RE::FUNCTION_DATA::FunctionID functionId;
+		bool isOR;
+		RE::CONDITION_ITEM_DATA::OpCode opCode;
+		float comparand;
+		Conditions::NativeConditions::Function function;
+		std::array<std::uint64_t, 3> params;
+	};
+
+	bool IsTrue(const Node* a_node)
+	{
+		// the old walk checked for custom functions on every node before dispatching
+		if (a_node->functionId == RE::FUNCTION_DATA::FunctionID::kGetVMQuestVariable) {
+			return false;
+		}
+		const auto value = a_node->function(nullptr, nullptr);
+		switch (a_node->opCode) {
+		case RE::CONDITION_ITEM_DATA::OpCode::kGreaterThan:
+			return value > a_node->comparand;
+		default:
+			return value == a_node->comparand;
+		}
+	}
+
+	bool ProgressOr(const Node*& a_node)
+	{
+		bool res = false;
+		bool inOR = true;
+		while (a_node && inOR) {
+			res = res || IsTrue(a_node);
+			inOR = a_node->isOR;
+			a_node = a_node->next;
+		}
+		return res;
+	}
+
+	bool ConditionsMet(const Node* a_head)
+	{
+		auto ptr = a_head;
+		while (ptr) {
+			bool result;
+			if (ptr->isOR) {
+				result = ProgressOr(ptr);
+			} else {
+				result = IsTrue(ptr);
+				ptr = ptr->next;
+			}
+			if (!result) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// @brief Member a_member of each OR group is the one which holds, earlier members fail
+	std::vector<std::string> RawChain(std::size_t a_member)
+	{
+		std::vector<std::string> ret{};
+		for (std::size_t g = 0; g < GROUPS; g++) {
+			for (std::size_t m = 0; m < GROUP_SIZE; m++) {
+				const auto connective = m + 1 < GROUP_SIZE ? " OR" : "";
+				ret.push_back(std::format("Native BenchValue{} > {}{}", m, m == a_member ? "0.1" : "2", connective));
+			}
+		}
+		return ret;
+	}
+}
+
+int main()
+{
+	for (std::size_t i = 0; i < GROUP_SIZE; i++) {
+		Conditions::NativeConditions::Register(std::format("BenchValue{}", i), { &Native, &values[i] });
+	}
+	// no aliases are used, so the map never needs a resolver
+	const auto refMap = std::make_shared<Conditions::RefMap>(std::map<std::string, std::string>{}, nullptr);
+
+	std::vector<Conditions::Conditional> compiled{};
+	std::vector<Node*> heads(CHAINS, nullptr);
+	std::vector<Node**> tails{};
+	for (std::size_t c = 0; c < CHAINS; c++) {
+		compiled.emplace_back(RawChain(c % GROUP_SIZE), *refMap);
+		compiled.back().Compile();
+		tails.push_back(&heads[c]);
+	}
+	// nodes are allocated one at a time across all chains, the way forms parsed over a whole load end up
+	std::vector<std::pair<std::size_t, std::size_t>> order{};
+	for (std::size_t i = 0; i < CHAINS * CHAIN_LENGTH; i++) {
+		order.emplace_back(i % CHAINS, 0);
+	}
+	std::vector<std::size_t> nextIndex(CHAINS, 0);
+	std::ranges::shuffle(order, std::mt19937_64{ 1 });
+	for (auto& [chain, index] : order) {
+		index = nextIndex[chain]++;
+		const auto member = index % GROUP_SIZE;
+		const auto node = new Node{
+			nullptr,
+			RE::FUNCTION_DATA::FunctionID::kGetIsID,
+			member + 1 < GROUP_SIZE,
+			RE::CONDITION_ITEM_DATA::OpCode::kGreaterThan,
+			member == chain % GROUP_SIZE ? 0.1f : 2.0f,
+			{ &Native, &values[member] },
+			{}
+		};
+		*tails[chain] = node;
+		tails[chain] = &node->next;
+	}
+
+	std::size_t next = 0;
+	Bench::Run("linked condition items, 32 conditions", 1'000'000, [&] { Bench::Consume(ConditionsMet(heads[next++ % CHAINS])); });
+	next = 0;
+	Bench::Run("compiled program, 32 conditions", 1'000'000, [&] { Bench::Consume(compiled[next++ % CHAINS].ConditionsMet(nullptr, nullptr)); });
+	return 0;
+}
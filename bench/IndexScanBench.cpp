@@ -0,0 +1,80 @@
+// Candidate scan throughput: records behind shared pointers under string keys (as before the record stores) against the packed ReplacementIndex
+#include <random>
+
+#include "Bench.h"
+
+#include "Dialogue/ReplacementStore.h"
+
+namespace
+{
+	constexpr std::size_t KEYS = 20'000;
+	constexpr std::size_t RECORDS_PER_KEY = 8;
+
+	/// @brief Stand-in for TopicInfo with the same hot fields and comparable cold data
+	struct Record
+	{
+		std::uint64_t priority;
+		bool random;
+		Conditions::Conditional conditions{};
+		std::vector<std::string> voices{ "MaleNord", "FemaleNord" };
+		std::vector<std::string> subtitles{ "A replacement subtitle of typical length.", "And a second line." };
+
+		_NODISCARD std::uint64_t GetPriority() const { return priority; }
+		_NODISCARD const Conditions::Conditional& GetConditions() const { return conditions; }
+		_NODISCARD std::uint32_t GetFlags() const { return random ? DDR::Entry::kRandom : DDR::Entry::kNone; }
+	};
+
+	/// @brief Keys are built on every lookup, as the dialogue hooks do
+	std::string Key(std::size_t a_key) { return std::format("{}|{}", a_key, "MaleNord"); }
+	std::uint64_t PackedKey(std::size_t a_key) { return (static_cast<std::uint64_t>(a_key) << 32) | 0x13AD2; }
+}
+
+int main()
+{
+	std::vector<std::string> keys{};
+	for (std::size_t i = 0; i < KEYS; i++) {
+		keys.push_back(Key(i));
+	}
+	// records are created in a shuffled order, the way files interleave keys, which scatters them over the heap
+	std::vector<std::pair<std::size_t, std::uint64_t>> order{};
+	for (std::size_t i = 0; i < KEYS * RECORDS_PER_KEY; i++) {
+		order.emplace_back(i % KEYS, i / KEYS);
+	}
+	std::ranges::shuffle(order, std::mt19937_64{ 1 });
+
+	std::unordered_map<std::string, std::vector<std::shared_ptr<Record>>> before{};
+	DDR::RecordStore<Record> store{};
+	DDR::ReplacementIndex<std::uint64_t> after{};
+	for (const auto& [key, priority] : order) {
+		before[keys[key]].push_back(std::make_shared<Record>(priority, priority % 3 == 0));
+		after.Stage(PackedKey(key), store.Insert(Record{ priority, priority % 3 == 0 }));
+	}
+	for (auto& [key, records] : before) {
+		std::ranges::stable_sort(records, std::ranges::greater{}, [](const auto& a_record) { return a_record->priority; });
+	}
+	store.shrink_to_fit();
+	after.Finalize(store);
+
+	std::size_t next = 0;
+	Bench::Run("shared_ptr records, full candidate scan", 1'000'000, [&] {
+		const auto& records = before.find(Key(next++ % KEYS))->second;
+		std::uint64_t sum = 0;
+		for (const auto& record : records) {
+			if (record->conditions.ConditionsMet(nullptr, nullptr)) {
+				sum += record->priority;
+			}
+		}
+		Bench::Consume(sum);
+	});
+	next = 0;
+	Bench::Run("ReplacementIndex entries, full candidate scan", 1'000'000, [&] {
+		std::uint64_t sum = 0;
+		for (const auto& entry : after.Find(PackedKey(next++ % KEYS))) {
+			if (entry.ConditionsMet(nullptr, nullptr)) {
+				sum += entry.priority;
+			}
+		}
+		Bench::Consume(sum);
+	});
+	return 0;
+}
@@ -0,0 +1,102 @@
+// Load throughput and peak heap of a large replacement file: the yaml-cpp document loader against the streaming loader
+// Heap use is tracked by replacing the global allocation functions, so it covers yaml-cpp and the records alike
+#include <fstream>
+
+#include "Bench.h"
+
+#include "Dialogue/ReplacementFile.h"
+
+namespace
+{
+	constexpr std::size_t TOPIC_INFOS = 100'000;
+	constexpr int RUNS = 3;
+
+	std::atomic<std::size_t> heapCurrent{ 0 };
+	std::atomic<std::size_t> heapPeak{ 0 };
+
+	// every block is prefixed with its size, which keeps the counters exact for unsized deletes
+	constexpr std::size_t HEADER = alignof(std::max_align_t);
+
+	void* Allocate(std::size_t a_size)
+	{
+		const auto block = static_cast<std::byte*>(std::malloc(a_size + HEADER));
+		if (!block) {
+			throw std::bad_alloc{};
+		}
+		*reinterpret_cast<std::size_t*>(block) = a_size;
+		const auto current = heapCurrent.fetch_add(a_size, std::memory_order_relaxed) + a_size;
+		auto peak = heapPeak.load(std::memory_order_relaxed);
+		while (current > peak && !heapPeak.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+		return block + HEADER;
+	}
+
+	void Free(void* a_ptr) noexcept
+	{
+		if (!a_ptr) {
+			return;
+		}
+		const auto block = static_cast<std::byte*>(a_ptr) - HEADER;
+		heapCurrent.fetch_sub(*reinterpret_cast<std::size_t*>(block), std::memory_order_relaxed);
+		std::free(block);
+	}
+
+	/// @brief A translation pack in the layout of the real ones, written once to the temp directory
+	fs::path WriteFile()
+	{
+		const auto path = fs::temp_directory_path() / "DDR_LoaderBench.yaml";
+		std::ofstream out{ path };
+		out << "refMap:\n  guard: \"0x0001A691|Skyrim.esm\"\n  jarl: \"0x00013BBD|Skyrim.esm\"\ntopicInfos:\n";
+		for (std::size_t i = 0; i < TOPIC_INFOS; i++) {
+			out << std::format(
+				"  - id: \"0x{:06X}|Skyrim.esm\"\n"
+				"    priority: {}\n"
+				"    random: {}\n"
+				"    voices: [MaleNord, FemaleNord, MaleGuard]\n"
+				"    conditions:\n"
+				"      - GetIsSex Female == 1 OR\n"
+				"      - GetActorValue Health >= {}\n"
+				"    responses:\n"
+				"      - subtitle: \"A replaced line of dialogue of a typical length, number {}.\"\n"
+				"        path: \"$Sound/Voice/Pack.esp/MaleNord/Line_{:06X}_1.xwm\"\n"
+				"      - keep: true\n",
+				i, i % 10, i % 7 == 0 ? "true" : "false", i % 100, i, i);
+		}
+		return path;
+	}
+
+	void Measure(const char* a_name, const fs::path& a_path, DDR::ReplacementFile (*a_load)(const fs::path&))
+	{
+		double best = std::numeric_limits<double>::max();
+		std::size_t peak = 0;
+		std::size_t records = 0;
+		for (int run = 0; run < RUNS; run++) {
+			const auto base = heapCurrent.load();
+			heapPeak = base;
+			const auto start = std::chrono::steady_clock::now();
+			const auto file = a_load(a_path);
+			const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+			best = std::min(best, elapsed.count());
+			peak = std::max(peak, heapPeak.load() - base);
+			records = file.topicInfos.size();
+		}
+		const auto size = static_cast<double>(fs::file_size(a_path));
+		std::printf("%-24s %8zu records %10.1f ms %10.1f MB/s %10.1f MB peak heap\n", a_name, records, best, size / (1024.0 * 1024.0) / (best / 1000.0), static_cast<double>(peak) / (1024.0 * 1024.0));
+	}
+}
+
+void* operator new(std::size_t a_size) { return Allocate(a_size); }
+void* operator new[](std::size_t a_size) { return Allocate(a_size); }
+void operator delete(void* a_ptr) noexcept { Free(a_ptr); }
+void operator delete[](void* a_ptr) noexcept { Free(a_ptr); }
+void operator delete(void* a_ptr, std::size_t) noexcept { Free(a_ptr); }
+void operator delete[](void* a_ptr, std::size_t) noexcept { Free(a_ptr); }
+
+int main()
+{
+	const auto path = WriteFile();
+	std::printf("%s, %.1f MB\n", path.string().c_str(), static_cast<double>(fs::file_size(path)) / (1024.0 * 1024.0));
+	Measure("document loader", path, &DDR::ReplacementFile::Load);
+	Measure("streaming loader", path, &DDR::ReplacementFile::Stream);
+	fs::remove(path);
+	return 0;
+}
@@ -0,0 +1,182 @@
+// Condition parsing throughput on a condition-heavy pack: a scan of the command table, a std::map and uppercase compares (as before)
+// against the condition function index and the frozen enum tables. The engine's command table cannot be read outside the game,
+// a synthetic table of the same size, holding the real names of the functions used, stands in for it
+#include <regex>
+
+#include "Bench.h"
+#include "EnumLookupBaseline.h"
+
+#include "Dialogue/Conditions/EnumLookup.h"
+
+namespace
+{
+	enum class Param
+	{
+		kForm,
+		kActorValue,
+		kSex,
+		kCastingSource,
+	};
+
+	struct Command
+	{
+		std::string functionName;
+		Param param;
+	};
+
+	/// @brief Conditions as they appear in replacement files, the tokens are split once up front
+	struct Line
+	{
+		std::string text;
+		std::string function;
+		std::string param;
+	};
+
+	constexpr std::array USED_FUNCTIONS{
+		std::pair{ "GetActorValue"sv, Param::kActorValue },
+		std::pair{ "GetActorValuePercent"sv, Param::kActorValue },
+		std::pair{ "GetBaseActorValue"sv, Param::kActorValue },
+		std::pair{ "GetIsSex"sv, Param::kSex },
+		std::pair{ "GetEquippedItemType"sv, Param::kCastingSource },
+		std::pair{ "IsInFaction"sv, Param::kForm },
+		std::pair{ "HasKeyword"sv, Param::kForm },
+		std::pair{ "GetIsID"sv, Param::kForm },
+		std::pair{ "GetIsRace"sv, Param::kForm },
+		std::pair{ "GetStage"sv, Param::kForm },
+	};
+
+	std::vector<Command> BuildCommands()
+	{
+		std::vector<Command> ret{};
+		for (std::uint16_t i = 0; i < RE::SCRIPT_FUNCTION::Commands::kScriptCommandsEnd; i++) {
+			ret.emplace_back(std::format("ScriptCommand{}", i), Param::kForm);
+		}
+		// spread over the table, so a scan finds them at the positions real functions have on average
+		for (std::size_t i = 0; i < USED_FUNCTIONS.size(); i++) {
+			auto& command = ret[(i * 2 + 1) * ret.size() / (USED_FUNCTIONS.size() * 2)];
+			command.functionName = USED_FUNCTIONS[i].first;
+			command.param = USED_FUNCTIONS[i].second;
+		}
+		return ret;
+	}
+
+	std::vector<Line> BuildPack()
+	{
+		constexpr std::array actorValues{ "OneHanded"sv, "Health"sv, "Destruction"sv, "Speechcraft"sv, "Aggression"sv, "Morality"sv, "Stamina"sv, "Sneak"sv };
+		std::vector<Line> ret{};
+		for (std::size_t i = 0; i < 10'000; i++) {
+			const auto& [function, param] = USED_FUNCTIONS[i % USED_FUNCTIONS.size()];
+			std::string arg;
+			switch (param) {
+			case Param::kActorValue:
+				arg = actorValues[i % actorValues.size()];
+				break;
+			case Param::kSex:
+				arg = i % 2 ? "Female" : "Male";
+				break;
+			case Param::kCastingSource:
+				arg = i % 2 ? "Left" : "Right";
+				break;
+			default:
+				arg = std::format("SomeEditorId{}", i % 97);
+				break;
+			}
+			ret.emplace_back(std::format("{} {} >= {}{}", function, arg, i % 100, i % 3 ? " AND" : " OR"), std::string{ function }, std::move(arg));
+		}
+		return ret;
+	}
+
+	/// @brief The pattern ConditionParser matches every condition against
+	const std::regex& GetConditionPattern()
+	{
+		static const std::regex re{
+			R"((\w+)\s+(([\w|.]+)(\s+([\w|.:]+))?\s*)?(==|!=|>|>=|<|<=)\s*(\w+)(\s+(AND|OR))?)"
+		};
+		return re;
+	}
+
+	/// @brief SCRIPT_FUNCTION::LocateScriptCommand over the synthetic table
+	const Command* ScanCommands(const std::vector<Command>& a_commands, const std::string& a_name)
+	{
+		for (const auto& command : a_commands) {
+			if (_strnicmp(command.functionName.c_str(), a_name.c_str(), a_name.size()) == 0) {
+				return std::addressof(command);
+			}
+		}
+		return nullptr;
+	}
+
+	std::uint64_t LookupBefore(const std::vector<Command>& a_commands, const std::string& a_function, const std::string& a_param)
+	{
+		const auto command = ScanCommands(a_commands, a_function);
+		switch (command ? command->param : Param::kForm) {
+		case Param::kActorValue:
+			return static_cast<std::uint64_t>(std::to_underlying(EnumLookupBaseline::LookupActorValue(a_param)));
+		case Param::kSex:
+			return static_cast<std::uint64_t>(std::to_underlying(EnumLookupBaseline::LookupSex(a_param)));
+		case Param::kCastingSource:
+			return static_cast<std::uint64_t>(std::to_underlying(EnumLookupBaseline::LookupCastingSource(a_param)));
+		default:
+			return reinterpret_cast<std::uintptr_t>(command);
+		}
+	}
+
+	template <class M>
+	std::uint64_t LookupAfter(const M& a_index, const std::string& a_function, const std::string& a_param)
+	{
+		const auto where = a_index.find(std::string_view{ a_function });
+		const auto command = where != a_index.end() ? where->second : nullptr;
+		switch (command ? command->param : Param::kForm) {
+		case Param::kActorValue:
+			return static_cast<std::uint64_t>(std::to_underlying(EnumLookup::LookupActorValue(a_param)));
+		case Param::kSex:
+			return static_cast<std::uint64_t>(std::to_underlying(EnumLookup::LookupSex(a_param)));
+		case Param::kCastingSource:
+			return static_cast<std::uint64_t>(std::to_underlying(EnumLookup::LookupCastingSource(a_param)));
+		default:
+			return reinterpret_cast<std::uintptr_t>(command);
+		}
+	}
+}
+
+int main()
+{
+	const auto commands = BuildCommands();
+	const auto pack = BuildPack();
+	// built once per load, the same way LocateConditionFunction indexes the engine's table
+	std::unordered_map<std::string_view, const Command*, Util::CaseInsensitiveHash, Util::CaseInsensitiveEqual> index{};
+	for (const auto& command : commands) {
+		index.try_emplace(command.functionName, std::addressof(command));
+	}
+
+	std::size_t next = 0;
+	const auto before = Bench::Run("function and parameter lookup, before", 1'000'000, [&] {
+		const auto& line = pack[next++ % pack.size()];
+		Bench::Consume(LookupBefore(commands, line.function, line.param));
+	});
+	next = 0;
+	const auto after = Bench::Run("function and parameter lookup, after", 1'000'000, [&] {
+		const auto& line = pack[next++ % pack.size()];
+		Bench::Consume(LookupAfter(index, line.function, line.param));
+	});
+	std::printf("%-48s %12.1fx\n", "lookup speedup", before / after);
+
+	next = 0;
+	const auto fullBefore = Bench::Run("pattern match and lookups, before", 200'000, [&] {
+		const auto& line = pack[next++ % pack.size()];
+		std::smatch m;
+		if (std::regex_match(line.text, m, GetConditionPattern())) {
+			Bench::Consume(LookupBefore(commands, m[1].str(), m[3].str()));
+		}
+	});
+	next = 0;
+	const auto fullAfter = Bench::Run("pattern match and lookups, after", 200'000, [&] {
+		const auto& line = pack[next++ % pack.size()];
+		std::smatch m;
+		if (std::regex_match(line.text, m, GetConditionPattern())) {
+			Bench::Consume(LookupAfter(index, m[1].str(), m[3].str()));
+		}
+	});
+	std::printf("%-48s %12.1fx\n", "full line speedup", fullBefore / fullAfter);
+	return 0;
+}
@@ -0,0 +1,67 @@
+// Draw throughput: the single shared std::mt19937 Random used before against the per-thread xoshiro256** streams
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Bench.h"
+
+#include "Util/Random.h"
+
+namespace
+{
+	constexpr std::size_t DRAWS = 10'000'000;
+	constexpr std::size_t THREADS = 4;
+
+	/// @brief Draw a_draws integers on each of a_threads threads and print the mean time per draw
+	template <class F>
+	void RunThreaded(const char* a_name, std::size_t a_threads, F&& a_draw)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		std::vector<std::thread> threads{};
+		for (std::size_t t = 0; t < a_threads; t++) {
+			threads.emplace_back([&, t] {
+				Random::bind(Random::Stream::kWorker, t);
+				std::uint64_t sum = 0;
+				for (std::size_t i = 0; i < DRAWS; i++) {
+					sum += a_draw();
+				}
+				Bench::Consume(sum);
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		std::printf("%-48s %12.1f ns/op\n", a_name, elapsed.count() / static_cast<double>(DRAWS * a_threads));
+	}
+}
+
+int main()
+{
+	Random::seed(1);
+	std::mt19937 shared{ 1 };
+	std::mutex sharedLock{};
+
+	Bench::Run("shared mt19937, draw<int>", DRAWS, [&] { Bench::Consume(std::uniform_int_distribution<int>{ 0, 99 }(shared)); });
+	Bench::Run("per-thread xoshiro256**, draw<int>", DRAWS, [] { Bench::Consume(Random::draw<int>(0, 99)); });
+	Bench::Run("shared mt19937, draw<float>", DRAWS, [&] { Bench::Consume(std::bit_cast<std::uint32_t>(std::uniform_real_distribution<float>{ 0.0f, 1.0f }(shared))); });
+	Bench::Run("per-thread xoshiro256**, draw<float>", DRAWS, [] { Bench::Consume(std::bit_cast<std::uint32_t>(Random::draw<float>(0.0f, 1.0f))); });
+	Bench::Run("per-thread xoshiro256**, generateUUID", DRAWS / 10, [] { Bench::Consume(Random::generateUUID().front()); });
+
+	// the shared generator was not synchronized, a lock is the least it needs to be drawn from several threads
+	RunThreaded("shared mt19937 behind a mutex, 4 threads", THREADS, [&] {
+		std::scoped_lock lock{ sharedLock };
+		return static_cast<std::uint64_t>(std::uniform_int_distribution<int>{ 0, 99 }(shared));
+	});
+	RunThreaded("per-thread xoshiro256**, 4 threads", THREADS, [] { return static_cast<std::uint64_t>(Random::draw<int>(0, 99)); });
+	return 0;
+}
@@ -0,0 +1,150 @@
+// Plugin side cost per topic of temporary topic replacements: a native call per topic returning a UUID key (as before)
+// against one batched call returning integer handles. Every Papyrus native call also waits for the game's main thread,
+// which a batch does once instead of once per topic. That part of the boundary can only be measured in game
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Bench.h"
+
+#include "Util/Random.h"
+
+namespace
+{
+	constexpr std::size_t TOPICS_PER_QUEST = 12;
+	constexpr std::size_t ROUNDS = 100'000;
+
+	/// @brief Stand-in for Topic, whose constructor looks the topic up in the game
+	struct Record
+	{
+		std::uint32_t id;
+		std::string text;
+	};
+
+	/// @brief The temporary store before handles: a UUID key per topic next to its record
+	class KeyedStore
+	{
+	public:
+		// arguments by value, the way the VM hands them to a native
+		std::string Add(std::uint32_t a_id, std::string a_text)
+		{
+			std::unique_lock lock{ _lock };
+			std::string key{ Random::generateUUID() };
+			_keys[a_id] = key;
+			_records[a_id] = std::make_shared<const Record>(a_id, a_text);
+			_count = _records.size();
+			return key;
+		}
+
+		void Remove(std::uint32_t a_id, std::string a_key)
+		{
+			std::unique_lock lock{ _lock };
+			if (_keys.count(a_id) && _keys[a_id] != a_key) {
+				return;
+			}
+			_keys.erase(a_id);
+			_records.erase(a_id);
+			_count = _records.size();
+		}
+
+	private:
+		std::unordered_map<std::uint32_t, std::string> _keys;
+		std::unordered_map<std::uint32_t, std::shared_ptr<const Record>> _records;
+		std::mutex _lock;
+		std::atomic<std::size_t> _count{ 0 };
+	};
+
+	/// @brief The temporary store with handles, as DialogueManager::AddReplacementTopics and RemoveReplacementTopics keep it
+	class HandleStore
+	{
+		struct Entry
+		{
+			std::int32_t handle;
+			std::shared_ptr<const Record> record;
+		};
+
+	public:
+		std::vector<std::int32_t> Add(std::span<const std::uint32_t> a_ids, std::span<const std::string> a_texts)
+		{
+			std::vector<std::shared_ptr<const Record>> records{};
+			records.reserve(a_ids.size());
+			for (std::size_t i = 0; i < a_ids.size(); i++) {
+				records.push_back(std::make_shared<const Record>(a_ids[i], a_texts[i]));
+			}
+			std::vector<std::int32_t> handles{};
+			handles.reserve(a_ids.size());
+			std::unique_lock lock{ _lock };
+			for (std::size_t i = 0; i < a_ids.size(); i++) {
+				std::int32_t handle;
+				do {
+					handle = static_cast<std::int32_t>(_next++ & 0x7FFF'FFFF);
+				} while (handle == 0);
+				_entries[a_ids[i]] = { handle, std::move(records[i]) };
+				handles.push_back(handle);
+			}
+			_count = _entries.size();
+			return handles;
+		}
+
+		void Remove(std::span<const std::uint32_t> a_ids, std::span<const std::int32_t> a_handles)
+		{
+			std::unique_lock lock{ _lock };
+			for (std::size_t i = 0; i < a_ids.size(); i++) {
+				if (const auto where = _entries.find(a_ids[i]); where != _entries.end() && where->second.handle == a_handles[i]) {
+					_entries.erase(where);
+				}
+			}
+			_count = _entries.size();
+		}
+
+	private:
+		std::unordered_map<std::uint32_t, Entry> _entries;
+		std::mutex _lock;
+		std::uint32_t _next{ 1 };
+		std::atomic<std::size_t> _count{ 0 };
+	};
+}
+
+int main()
+{
+	std::array<std::uint32_t, TOPICS_PER_QUEST> ids{};
+	std::array<std::string, TOPICS_PER_QUEST> texts{};
+	for (std::size_t i = 0; i < TOPICS_PER_QUEST; i++) {
+		ids[i] = 0x0001'0000 + static_cast<std::uint32_t>(i);
+		texts[i] = "Retitled topic number " + std::to_string(i) + ", with a text of typical length";
+	}
+
+	KeyedStore keyed{};
+	const auto before = Bench::Run("a call per topic, UUID keys (12 topics)", ROUNDS, [&] {
+		std::array<std::string, TOPICS_PER_QUEST> keys{};
+		for (std::size_t i = 0; i < TOPICS_PER_QUEST; i++) {
+			keys[i] = keyed.Add(ids[i], texts[i]);
+		}
+		for (std::size_t i = 0; i < TOPICS_PER_QUEST; i++) {
+			keyed.Remove(ids[i], keys[i]);
+		}
+	});
+
+	HandleStore handles{};
+	const auto after = Bench::Run("one batched call, integer handles (12 topics)", ROUNDS, [&] {
+		// the VM copies both arrays into the native's arguments
+		const std::vector<std::uint32_t> idArgs{ ids.begin(), ids.end() };
+		const std::vector<std::string> textArgs{ texts.begin(), texts.end() };
+		const auto added = handles.Add(idArgs, textArgs);
+		handles.Remove(idArgs, added);
+	});
+	std::printf("%-48s %12.1f ns/topic\n", "a call per topic", before / TOPICS_PER_QUEST);
+	std::printf("%-48s %12.1f ns/topic\n", "one batched call", after / TOPICS_PER_QUEST);
+	return 0;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+/*
+ * Native interface of Dynamic Dialogue Replacer, for other SKSE plugins.
+ *
+ * Request it through SKSE messaging, from kPostLoad onwards:
+ *
+ *   DDR_InterfaceRequest request{ DDR_API_VERSION, nullptr };
+ *   SKSE::GetMessagingInterface()->Dispatch(DDR_MESSAGE_REQUEST_INTERFACE, &request, sizeof(request), DDR_PLUGIN_NAME);
+ *   if (request.result) { ... }
+ *
+ * The request is answered synchronously. The interface stays valid for the lifetime of the process.
+ * Texts are UTF-8 and are not null terminated unless stated otherwise.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#ifndef __cplusplus
+#	include <stdbool.h>
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define DDR_PLUGIN_NAME "DynamicDialogueReplacer"
+#define DDR_API_VERSION 1
+#define DDR_MESSAGE_REQUEST_INTERFACE 0x44445249u	 // 'DDRI'
+
+/// Returned by a text replacer to keep its input, or by a query if nothing replaces the text
+#define DDR_NO_TEXT ((size_t)-1)
+
+	typedef enum DDR_ReplacementType
+	{
+		DDR_REPLACEMENT_ANY = 0,
+		DDR_REPLACEMENT_TOPIC = 1,
+		DDR_REPLACEMENT_RESPONSE = 2,
+	} DDR_ReplacementType;
+
+	typedef struct DDR_StringView
+	{
+		const char* data;
+		size_t size;
+	} DDR_StringView;
+
+	typedef struct DDR_TextContext
+	{
+		uint32_t speaker;	 // form id, 0 if unknown
+		uint32_t target;	 // form id, 0 if unknown
+		DDR_ReplacementType type;
+	} DDR_TextContext;
+
+	/// Write the replaced text to a_buffer and return its length, or DDR_NO_TEXT to keep a_text.
+	/// If the replacement does not fit, return its length without writing, the call is repeated once with a buffer of that size.
+	/// Called on the thread the dialogue is processed on, in the order of priority shared with Lua scripts.
+	typedef size_t (*DDR_TextReplacerFn)(void* a_user, const DDR_TextContext* a_context, DDR_StringView a_text, char* a_buffer, size_t a_capacity);
+
+	/// Evaluate a condition for a RE::TESObjectREFR* subject and target, either may be null.
+	/// Used in replacement files as "Native <name> [op value] [AND|OR]", without an operator the result is compared != 0
+	typedef float (*DDR_ConditionFn)(void* a_user, void* a_subject, void* a_target);
+
+	typedef struct DDR_TextReplacerInfo
+	{
+		const char* name;	 // null terminated, used in the log
+		DDR_TextReplacerFn callback;
+		void* user;	 // passed to every call of callback
+		DDR_ReplacementType type;
+		uint32_t speaker;	 // form id the replacer is limited to, 0 for any
+		uint32_t target;	 // form id the replacer is limited to, 0 for any
+		int32_t priority;	 // higher runs first. On equal priority, Lua scripts run before native replacers
+	} DDR_TextReplacerInfo;
+
+	typedef struct DDR_Interface
+	{
+		uint32_t version;
+
+		/// Add a replacer for dialogue texts. Returns false if a_info is incomplete
+		bool (*RegisterTextReplacer)(const DDR_TextReplacerInfo* a_info);
+		/// Add a condition function usable in replacement files. a_name is null terminated and compared case insensitively.
+		/// Register before game data is loaded, conditions may be compiled from then on. Returns false if the name is taken
+		bool (*RegisterCondition)(const char* a_name, DDR_ConditionFn a_function, void* a_user);
+
+		/// Subtitle replacing response a_responseNumber of a RE::TESTopicInfo* spoken by a RE::Character*.
+		/// Returns its length, written to a_buffer with a null terminator if it fits, or DDR_NO_TEXT.
+		/// Has no side effects: of random replacements, the first whose conditions hold is returned instead of drawing one
+		size_t (*GetReplacementSubtitle)(void* a_speaker, void* a_topicInfo, int32_t a_responseNumber, char* a_buffer, size_t a_capacity);
+		/// Text replacing a topic, as shown in the dialogue menu of a RE::TESObjectREFR* before scripts run.
+		/// Returns its length, written to a_buffer with a null terminator if it fits, or DDR_NO_TEXT
+		size_t (*GetReplacementTopicText)(uint32_t a_parentTopic, uint32_t a_topic, void* a_target, char* a_buffer, size_t a_capacity);
+	} DDR_Interface;
+
+	typedef struct DDR_InterfaceRequest
+	{
+		uint32_t version;	 // DDR_API_VERSION the requesting plugin was built with
+		const DDR_Interface* result;	// set by DDR, null if the version is not supported
+	} DDR_InterfaceRequest;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,93 @@
+#include "NativeAPI.h"
+
+#include "DDRAPI.h"
+#include "Dialogue/Conditions/NativeConditions.h"
+#include "Dialogue/DialogueManager.h"
+
+namespace DDR::API
+{
+	namespace
+	{
+		/// @brief Copy a_text into a caller owned buffer, with a null terminator if it fits. @return the length of a_text
+		size_t CopyOut(std::string_view a_text, char* a_buffer, size_t a_capacity)
+		{
+			if (a_buffer && a_text.size() < a_capacity) {
+				std::memcpy(a_buffer, a_text.data(), a_text.size());
+				a_buffer[a_text.size()] = '\0';
+			}
+			return a_text.size();
+		}
+
+		bool RegisterTextReplacer(const DDR_TextReplacerInfo* a_info)
+		{
+			return a_info && DialogueManager::GetSingleton()->RegisterNativeReplacer(*a_info);
+		}
+
+		bool RegisterCondition(const char* a_name, DDR_ConditionFn a_function, void* a_user)
+		{
+			if (!a_name || !*a_name || !a_function) {
+				return false;
+			}
+			if (!Conditions::NativeConditions::Register(a_name, { a_function, a_user })) {
+				logger::error("Failed to register native condition {} - name already taken", a_name);
+				return false;
+			}
+			logger::info("Registered native condition {}", a_name);
+			return true;
+		}
+
+		size_t GetReplacementSubtitle(void* a_speaker, void* a_topicInfo, int32_t a_responseNumber, char* a_buffer, size_t a_capacity)
+		{
+			const auto speaker = static_cast<RE::Character*>(a_speaker);
+			const auto topicInfo = static_cast<RE::TESTopicInfo*>(a_topicInfo);
+			const auto response = DialogueManager::GetSingleton()->PeekReplacementResponse(speaker, topicInfo);
+			if (!response || a_responseNumber < 1 || !response->HasReplacementSubtitle(a_responseNumber)) {
+				return DDR_NO_TEXT;
+			}
+			PlaceholderValues values{};
+			values.Bind(speaker, DialogueManager::GetDialogueTarget(speaker));
+			return CopyOut(response->GetSubtitle(a_responseNumber).Expand(values), a_buffer, a_capacity);
+		}
+
+		size_t GetReplacementTopicText(uint32_t a_parentTopic, uint32_t a_topic, void* a_target, char* a_buffer, size_t a_capacity)
+		{
+			const auto target = static_cast<RE::TESObjectREFR*>(a_target);
+			for (auto&& topic : DialogueManager::GetSingleton()->FindReplacementTopic(a_parentTopic, a_topic, target, false)) {
+				if (!topic->GetText().empty()) {
+					PlaceholderValues values{};
+					values.Bind(target, RE::PlayerCharacter::GetSingleton());
+					return CopyOut(topic->GetText().Expand(values), a_buffer, a_capacity);
+				}
+			}
+			return DDR_NO_TEXT;
+		}
+
+		constexpr DDR_Interface INTERFACE{
+			DDR_API_VERSION,
+			&RegisterTextReplacer,
+			&RegisterCondition,
+			&GetReplacementSubtitle,
+			&GetReplacementTopicText,
+		};
+	}
+
+	void HandleMessage(SKSE::MessagingInterface::Message* a_message)
+	{
+		if (!a_message || a_message->type != DDR_MESSAGE_REQUEST_INTERFACE) {
+			return;
+		}
+		const auto sender = a_message->sender ? a_message->sender : "<unknown>";
+		if (a_message->dataLen != sizeof(DDR_InterfaceRequest) || !a_message->data) {
+			logger::error("Malformed interface request from {}", sender);
+			return;
+		}
+		auto& request = *static_cast<DDR_InterfaceRequest*>(a_message->data);
+		if (request.version == 0 || request.version > DDR_API_VERSION) {
+			logger::error("{} requested interface version {}, the newest supported version is {}", sender, request.version, DDR_API_VERSION);
+			request.result = nullptr;
+			return;
+		}
+		request.result = std::addressof(INTERFACE);
+		logger::info("Provided interface version {} to {}", request.version, sender);
+	}
+}	 // namespace DDR::API
@@ -0,0 +1,7 @@
+#pragma once
+
+namespace DDR::API
+{
+	/// @brief Answer interface requests of other plugins, see DDRAPI.h. Registered as a listener for every sender
+	void HandleMessage(SKSE::MessagingInterface::Message* a_message);
+}	 // namespace DDR::API
@@ -6,18 +6,45 @@ using namespace Conditions;
 
 // stolen from DAV (https://github.com/Exit-9B/DynamicArmorVariants)
 
+namespace
+{
+	/// @brief Function [param1 [param2]] op comparand [AND|OR]
+	const std::regex& GetConditionPattern()
+	{
+		static const std::regex re{
+			R"((\w+)\s+(([\w|.]+)(\s+([\w|.:]+))?\s*)?(==|!=|>|>=|<|<=)\s*(\w+)(\s+(AND|OR))?)"
+		};
+		return re;
+	}
+}
+
+bool ConditionParser::Validate(std::string_view a_text)
+{
+	// only the function name is read, the pattern is matched once the condition is built
+	const auto subject = a_text.find("<>"sv);
+	const auto text = subject == std::string_view::npos ? a_text : a_text.substr(subject + 2);
+	const auto end = std::ranges::find_if_not(text, [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; });
+	const std::string name{ text.begin(), end };
+	if (name.empty()) {
+		logger::error("Could not parse condition: {}"sv, a_text);
+		return false;
+	}
+	const auto function = LocateConditionFunction(name);
+	if (!function || !function->conditionFunction) {
+		logger::error("Did not find condition function: {}"sv, name);
+		return false;
+	}
+	return true;
+}
+
 RE::TESConditionItem* ConditionParser::Parse(std::string_view a_text, const RefMap& a_refMap)
 {
 	const auto splits = Util::StringSplitToOwned(std::string{ a_text }, "<>"sv);
 	const std::string text{ splits.size() == 2 ? splits[1] : splits[0] };
 	const std::string refStr{ splits.size() == 2 ? splits[0] : "" };
 
-	static const std::regex re{
-		R"((\w+)\s+(([\w|.]+)(\s+([\w|.:]+))?\s*)?(==|!=|>|>=|<|<=)\s*(\w+)(\s+(AND|OR))?)"
-	};
-
 	std::smatch m;
-	if (!std::regex_match(text, m, re)) {
+	if (!std::regex_match(text, m, GetConditionPattern())) {
 		logger::error("Could not parse condition: {}"sv, a_text);
 		return nullptr;
 	}
@@ -32,7 +59,7 @@ RE::TESConditionItem* ConditionParser::Parse(std::string_view a_text, const RefM
 	logger::debug("Matching {}. Results: Func: {}, Param1: {}, Param2: {}, Operator: {}, Comparand: {}, Connective: {}",
 			text, mFunction.str(), mParam1.str(), mParam2.str(), mOperator.str(), mComparand.str(), mConnective.str());
 
-	auto function = RE::SCRIPT_FUNCTION::LocateScriptCommand(mFunction.str().data());
+	auto function = LocateConditionFunction(mFunction.str());
 	if (!function || !function->conditionFunction) {
 		logger::error("Did not find condition function: {}"sv, mFunction.str());
 		return nullptr;
@@ -130,6 +157,29 @@ std::shared_ptr<RE::TESCondition> ConditionParser::ParseConditions(const std::ve
 	return numConditions ? condition : nullptr;
 }
 
+RE::SCRIPT_FUNCTION* ConditionParser::LocateConditionFunction(const std::string& a_name)
+{
+	// the command table is static, so it only has to be indexed once
+	static const auto functions = [] {
+		std::unordered_map<std::string_view, RE::SCRIPT_FUNCTION*, Util::CaseInsensitiveHash, Util::CaseInsensitiveEqual> map{};
+		const auto commands = RE::SCRIPT_FUNCTION::GetFirstScriptCommand();
+		for (std::uint16_t i = 0; i < RE::SCRIPT_FUNCTION::Commands::kScriptCommandsEnd; i++) {
+			auto& command = commands[i];
+			if (!command.conditionFunction)
+				continue;
+			if (command.functionName && *command.functionName)
+				map.try_emplace(command.functionName, std::addressof(command));
+		}
+		logger::info("Indexed {} condition function names", map.size());
+		return map;
+	}();
+	if (const auto where = functions.find(std::string_view{ a_name }); where != functions.end()) {
+		return where->second;
+	}
+	// anything else resolves through the table scan used before the index existed
+	return RE::SCRIPT_FUNCTION::LocateScriptCommand(a_name.c_str());
+}
+
 ConditionParser::ConditionParam ConditionParser::ParseParam(const std::string& a_text, RE::SCRIPT_PARAM_TYPE a_type, const RefMap& a_refMap)
 {
 	ConditionParam param{};
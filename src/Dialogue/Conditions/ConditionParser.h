@@ -12,6 +12,8 @@ namespace Conditions
 	public:
 		ConditionParser() = delete;
 
+		/// @brief Check the function name of a condition, without matching the rest of it or resolving its parameters. Errors are logged
+		static bool Validate(std::string_view a_text);
 		static RE::TESConditionItem* Parse(std::string_view a_text, const RefMap& a_refMap);
 		static std::shared_ptr<RE::TESCondition> ParseConditions(const std::vector<std::string>& a_rawConditions, const RefMap& a_refMap);
 
@@ -25,6 +27,8 @@ namespace Conditions
 			RE::BSString* str;
 		};
 
+		/// @brief Exact, case insensitive lookup of a condition function by its long name
+		static RE::SCRIPT_FUNCTION* LocateConditionFunction(const std::string& a_name);
 		static ConditionParam ParseParam(const std::string& a_text, RE::SCRIPT_PARAM_TYPE a_type, const RefMap& a_refMap);
 	};
 }
@@ -1,80 +1,238 @@
 #include "Conditional.h"
 
+#include "Stats.h"
 #include "Util/StringUtil.h"
 #include "Util/Script.h"
 
 namespace Conditions
 {
+	namespace
+	{
+		const std::regex& GetNativePattern()
+		{
+			static const std::regex re{
+				R"(Native\s+([\w.:]+)(\s*(==|!=|>=|<=|>|<)\s*(-?[\d.]+))?(\s+(AND|OR))?\s*)", std::regex::icase
+			};
+			return re;
+		}
+	}
+
+	Conditional::Conditional(std::vector<std::string> a_rawConditions, const RefMap& a_refMap)
+	{
+		std::erase_if(a_rawConditions, [](const auto& str) { return str.empty(); });
+		if (a_rawConditions.empty()) {
+			return;
+		}
+		// building is deferred, but unknown functions are still reported while the file loads
+		for (const auto& text : a_rawConditions) {
+			const bool valid = IsNative(text) ? ValidateNative(text) : ConditionParser::Validate(text);
+			if (!valid) {
+				throw std::runtime_error("Failed to parse condition: " + text);
+			}
+		}
+		_pending = std::make_unique<Pending>(std::move(a_rawConditions), a_refMap.shared_from_this());
+	}
+
+	void Conditional::Compile() const
+	{
+		if (!_pending) {
+			return;
+		}
+		std::call_once(_pending->once, [this]() { Build(); });
+	}
+
 	bool Conditional::ConditionsMet(RE::TESObjectREFR* a_subject, RE::TESObjectREFR* a_target) const
 	{
-		if (!_conditions) {
-			return true;
+		Compile();
+		if (_pending && _pending->failed) {
+			return false;
 		}
 		RE::ConditionCheckParams params{ a_subject, a_target };
-		auto ptr = _conditions->head;
-		while (ptr) {
-			bool result;
-			if (ptr->data.flags.isOR) {
-				result = ProgressOr(ptr, params);
-			} else {
-				result = IsTrue(ptr, params);
-				ptr = ptr->next;
-			}
-			if (!result) {
+		size_t pc = 0;
+		while (pc < _program.size()) {
+			const auto& op = _program[pc];
+			const bool result = op.handler ? op.handler(*this, op, params) : op.item.IsTrue(params);
+			if (result) {
+				pc = op.onTrue;
+			} else if (op.last) {
 				return false;
+			} else {
+				pc++;
 			}
 		}
 		return true;
 	}
 
-	bool Conditional::ProgressOr(RE::TESConditionItem*& a_item, RE::ConditionCheckParams& a_params)
+	void Conditional::Build() const
 	{
-		bool res = false;
-		bool inOR = true;
-		while (a_item && inOR) {
-			res = res || IsTrue(a_item, a_params);
-			inOR = a_item->data.flags.isOR;
-			a_item = a_item->next;
-		}
-		return res;
+		try {
+			RE::TESConditionItem** tail = nullptr;
+			for (const auto& text : _pending->rawConditions) {
+				if (IsNative(text)) {
+					_program.push_back(ParseNative(text));
+					continue;
+				}
+				const auto item = ConditionParser::Parse(text, *_pending->refMap);
+				if (!item) {
+					throw std::runtime_error("Failed to parse condition: " + text);
+				}
+				if (!_conditions) {
+					_conditions = std::make_shared<RE::TESCondition>();
+					tail = std::addressof(_conditions->head);
+				}
+				*tail = item;
+				tail = std::addressof(item->next);
+				auto& op = _program.emplace_back();
+				op.item.data = item->data;
+				const auto function = item->data.functionData.function.get();
+				for (const auto& custom : CUSTOM_FUNCTIONS) {
+					if (custom.function == function) {
+						op.handler = custom.handler;
+						op.payload = custom.prepare(*this, *item);
+						break;
+					}
+				}
+			}
+		} catch (const std::exception& e) {
+			logger::error("Failed to parse conditions [{}] - {}. Replacement disabled", Util::StringJoin(_pending->rawConditions, ", "), e.what());
+			_pending->failed = true;
+			_program.clear();
+		}
+		_pending->rawConditions = {};
+		_pending->refMap.reset();
+		Stats::Add(Stats::conditionsCompiled);
+		// an OR group runs up to and including the first condition without the OR flag
+		size_t groupBegin = 0;
+		for (size_t i = 0; i < _program.size(); i++) {
+			if (_program[i].item.data.flags.isOR && i + 1 < _program.size()) {
+				continue;
+			}
+			_program[i].last = true;
+			for (size_t j = groupBegin; j <= i; j++) {
+				_program[j].onTrue = static_cast<std::uint32_t>(i + 1);
+			}
+			groupBegin = i + 1;
+		}
+		_program.shrink_to_fit();
 	}
 
-	bool Conditional::IsTrue(RE::TESConditionItem* a_item, RE::ConditionCheckParams& a_params)
+	bool Conditional::Compare(RE::CONDITION_ITEM_DATA::OpCode a_opCode, float a_value, float a_comparand)
 	{
-		// depending on type use custom logic instead
-		const auto type = a_item->data.functionData.function.get();
-		if (type != RE::FUNCTION_DATA::FunctionID::kGetVMQuestVariable) {
-			return a_item->IsTrue(a_params);
-		}
-		const auto quest = std::bit_cast<RE::TESQuest*>(a_item->data.functionData.params[0]);
-		const auto scriptVar = std::bit_cast<RE::BSString*>(a_item->data.functionData.params[1]);
-		const auto splits = Util::StringSplitToOwned(scriptVar->c_str(), "::");
-		const auto script = splits[0];
-		const auto var = splits[1];
-		float value;
-		if (const auto questObj = Script::GetScriptObject(quest, script.c_str())) {
-			value = Script::GetProperty<float>(questObj, var);
-		} else {
-			logger::error("Failed to get script object: {} from quest: {}", script.c_str(), quest->GetFormID());
-			value = 0.0f;
-		}
-		const auto comparand = a_item->data.flags.global ? a_item->data.comparisonValue.g->value : a_item->data.comparisonValue.f;
-		switch (a_item->data.flags.opCode) {
+		switch (a_opCode) {
 		case RE::CONDITION_ITEM_DATA::OpCode::kEqualTo:
-			return value == comparand;
+			return a_value == a_comparand;
 		case RE::CONDITION_ITEM_DATA::OpCode::kNotEqualTo:
-			return value == comparand;
+			return a_value != a_comparand;
 		case RE::CONDITION_ITEM_DATA::OpCode::kGreaterThan:
-			return value > comparand;
+			return a_value > a_comparand;
 		case RE::CONDITION_ITEM_DATA::OpCode::kGreaterThanOrEqualTo:
-			return value >= comparand;
+			return a_value >= a_comparand;
 		case RE::CONDITION_ITEM_DATA::OpCode::kLessThan:
-			return value < comparand;
+			return a_value < a_comparand;
 		case RE::CONDITION_ITEM_DATA::OpCode::kLessThanOrEqualTo:
-			return value <= comparand;
+			return a_value <= a_comparand;
 		default:
 			return false;
 		}
 	}
 
+	float Conditional::GetComparand(const RE::CONDITION_ITEM_DATA& a_data)
+	{
+		return a_data.flags.global ? a_data.comparisonValue.g->value : a_data.comparisonValue.f;
+	}
+
+	bool Conditional::IsNative(std::string_view a_text)
+	{
+		const auto prefix = NativeConditions::PREFIX;
+		return a_text.size() > prefix.size() && Util::CaseInsensitiveEqual{}(a_text.substr(0, prefix.size()), prefix) &&
+		       std::isspace(static_cast<unsigned char>(a_text[prefix.size()]));
+	}
+
+	bool Conditional::ValidateNative(std::string_view a_text)
+	{
+		auto name = a_text.substr(NativeConditions::PREFIX.size());
+		name.remove_prefix(std::min(name.find_first_not_of(" \t"sv), name.size()));
+		name = name.substr(0, name.find_first_of(" \t=!<>"sv));
+		if (name.empty()) {
+			logger::error("Could not parse native condition: {}", a_text);
+			return false;
+		}
+		if (!NativeConditions::Find(name)) {
+			logger::error("No native condition function named {} is registered", name);
+			return false;
+		}
+		return true;
+	}
+
+	Conditional::Op Conditional::ParseNative(const std::string& a_text) const
+	{
+		std::smatch m;
+		if (!std::regex_match(a_text, m, GetNativePattern())) {
+			throw std::runtime_error(std::format("Could not parse native condition: {}", a_text));
+		}
+		const auto function = NativeConditions::Find(m[1].str());
+		if (!function) {
+			throw std::runtime_error(std::format("No native condition function named {} is registered", m[1].str()));
+		}
+		Op op{};
+		auto& data = op.item.data;
+		data.flags.opCode = RE::CONDITION_ITEM_DATA::OpCode::kNotEqualTo;
+		data.comparisonValue.f = 0.0f;
+		if (m[3].matched) {
+			static constexpr std::array opCodes{
+				std::pair{ "=="sv, RE::CONDITION_ITEM_DATA::OpCode::kEqualTo },
+				std::pair{ "!="sv, RE::CONDITION_ITEM_DATA::OpCode::kNotEqualTo },
+				std::pair{ ">"sv, RE::CONDITION_ITEM_DATA::OpCode::kGreaterThan },
+				std::pair{ ">="sv, RE::CONDITION_ITEM_DATA::OpCode::kGreaterThanOrEqualTo },
+				std::pair{ "<"sv, RE::CONDITION_ITEM_DATA::OpCode::kLessThan },
+				std::pair{ "<="sv, RE::CONDITION_ITEM_DATA::OpCode::kLessThanOrEqualTo },
+			};
+			const auto opStr = m[3].str();
+			for (const auto& [str, opCode] : opCodes) {
+				if (str == opStr) {
+					data.flags.opCode = opCode;
+				}
+			}
+			data.comparisonValue.f = std::stof(m[4].str());
+		}
+		data.flags.isOR = m[6].matched && Util::CaseInsensitiveEqual{}(m[6].str(), "OR"sv);
+		op.handler = &CallNative;
+		_natives.push_back(*function);
+		op.payload = static_cast<std::uint32_t>(_natives.size() - 1);
+		return op;
+	}
+
+	bool Conditional::CallNative(const Conditional& a_this, const Op& a_op, RE::ConditionCheckParams& a_params)
+	{
+		const auto& data = a_op.item.data;
+		const auto value = a_this._natives[a_op.payload](a_params.actionRef, a_params.targetRef);
+		return Compare(data.flags.opCode, value, GetComparand(data));
+	}
+
+	std::uint32_t Conditional::PrepareVMQuestVariable(const Conditional& a_this, const RE::TESConditionItem& a_item)
+	{
+		const auto scriptVar = std::bit_cast<RE::BSString*>(a_item.data.functionData.params[1]);
+		auto splits = Util::StringSplitToOwned(scriptVar->c_str(), "::");
+		if (splits.size() != 2) {
+			throw std::runtime_error(std::format("Invalid script variable: {}, expected Script::Variable", scriptVar->c_str()));
+		}
+		a_this._vmVariables.emplace_back(std::move(splits[0]), RE::BSFixedString{ splits[1] });
+		return static_cast<std::uint32_t>(a_this._vmVariables.size() - 1);
+	}
+
+	bool Conditional::GetVMQuestVariable(const Conditional& a_this, const Op& a_op, RE::ConditionCheckParams&)
+	{
+		const auto& data = a_op.item.data;
+		const auto quest = std::bit_cast<RE::TESQuest*>(data.functionData.params[0]);
+		const auto& [script, var] = a_this._vmVariables[a_op.payload];
+		float value;
+		if (const auto questObj = Script::GetScriptObject(quest, script.c_str())) {
+			value = Script::GetProperty<float>(questObj, var);
+		} else {
+			logger::error("Failed to get script object: {} from quest: {}", script, quest->GetFormID());
+			value = 0.0f;
+		}
+		return Compare(data.flags.opCode, value, GetComparand(data));
+	}
+
 } // namespace Condition
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ConditionParser.h"
+#include "NativeConditions.h"
 #include "RefMap.h"
 
 namespace Conditions
@@ -8,19 +9,81 @@ namespace Conditions
 	struct Conditional
 	{
 		Conditional() = default;
-		Conditional(const std::vector<std::string>& a_rawConditions, const RefMap& a_refMap) :
-			_conditions(ConditionParser::ParseConditions(a_rawConditions, a_refMap)) {}
+		/// @brief Conditions are only parsed on first evaluation or Compile(). The ref map is kept alive until then
+		Conditional(std::vector<std::string> a_rawConditions, const RefMap& a_refMap);
 		~Conditional() = default;
+		Conditional(Conditional&&) = default;
+		Conditional& operator=(Conditional&&) = default;
 
 	public:
 		_NODISCARD bool ConditionsMet(RE::TESObjectREFR* a_subject, RE::TESObjectREFR* a_target) const;
+		/// @brief Parse and compile the conditions if that has not happened yet. Thread safe
+		void Compile() const;
 
-		operator bool() const { return _conditions != nullptr; }
+		operator bool() const { return _pending || !_program.empty(); }
 
 	private:
-		static bool ProgressOr(RE::TESConditionItem*& a_item, RE::ConditionCheckParams& a_params);
-		static bool IsTrue(RE::TESConditionItem* a_item, RE::ConditionCheckParams& a_params);
+		struct Op;
+		using Handler = bool (*)(const Conditional& a_this, const Op& a_op, RE::ConditionCheckParams& a_params);
 
-		std::shared_ptr<RE::TESCondition> _conditions{ nullptr };
+		/// @brief A single condition of the compiled program
+		struct Op
+		{
+			RE::TESConditionItem item{};	// copy of the parsed condition, never linked
+			Handler handler{ nullptr };		// custom implementation, null for engine functions
+			std::uint32_t payload{ 0 };		// handler specific, e.g. an index into _vmVariables
+			std::uint32_t onTrue{ 0 };		// op to continue at if this one holds, skipping the rest of its OR group
+			bool last{ false };						// last op of its OR group, failing it fails the chain
+		};
+
+		/// @brief Condition functions evaluated by DDR instead of the engine
+		struct CustomFunction
+		{
+			RE::FUNCTION_DATA::FunctionID function;
+			Handler handler;
+			std::uint32_t (*prepare)(const Conditional& a_this, const RE::TESConditionItem& a_item);
+		};
+
+		struct VMVariable
+		{
+			std::string script;
+			RE::BSFixedString variable;
+		};
+
+		/// @brief Raw conditions awaiting their first use
+		struct Pending
+		{
+			std::vector<std::string> rawConditions;
+			std::shared_ptr<const RefMap> refMap;
+			std::once_flag once{};
+			bool failed{ false };
+		};
+
+		/// @brief Parse the raw conditions and flatten them into _program
+		void Build() const;
+
+		static bool Compare(RE::CONDITION_ITEM_DATA::OpCode a_opCode, float a_value, float a_comparand);
+		static float GetComparand(const RE::CONDITION_ITEM_DATA& a_data);
+
+		_NODISCARD static bool IsNative(std::string_view a_text);
+		/// @brief Check that the function of a native condition is registered, the rest is parsed once the condition is built. Errors are logged
+		_NODISCARD static bool ValidateNative(std::string_view a_text);
+		/// @brief Op for a "Native <name> [op value] [AND|OR]" condition, evaluated by a function registered through the native interface
+		Op ParseNative(const std::string& a_text) const;
+		static bool CallNative(const Conditional& a_this, const Op& a_op, RE::ConditionCheckParams& a_params);
+
+		static std::uint32_t PrepareVMQuestVariable(const Conditional& a_this, const RE::TESConditionItem& a_item);
+		static bool GetVMQuestVariable(const Conditional& a_this, const Op& a_op, RE::ConditionCheckParams& a_params);
+
+		static constexpr std::array CUSTOM_FUNCTIONS{
+			CustomFunction{ RE::FUNCTION_DATA::FunctionID::kGetVMQuestVariable, &GetVMQuestVariable, &PrepareVMQuestVariable },
+		};
+
+		std::unique_ptr<Pending> _pending{ nullptr };
+		// built lazily, never modified after Compile() returned
+		mutable std::shared_ptr<RE::TESCondition> _conditions{ nullptr };	 // owns parameters referenced by the program
+		mutable std::vector<Op> _program{};
+		mutable std::vector<VMVariable> _vmVariables{};
+		mutable std::vector<NativeConditions::Function> _natives{};
 	};
 } // namespace Condition
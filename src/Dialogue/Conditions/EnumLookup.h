@@ -1,22 +1,26 @@
 #pragma once
 
+#include <frozen/string.h>
+#include <frozen/unordered_map.h>
+
+#include "Util/StringUtil.h"
+
 // stolen from DAV (https://github.com/Exit-9B/DynamicArmorVariants)
 
 class EnumLookup
 {
+	template <class V, std::size_t N>
+	using Table = frozen::unordered_map<frozen::string, V, N, Util::CaseInsensitiveHash, Util::CaseInsensitiveEqual>;
+
 public:
 	EnumLookup() = delete;
 
-	static auto LookupActorValue(const std::string& a_str) -> RE::ActorValue
+	static auto LookupActorValue(std::string_view a_str) -> RE::ActorValue
 	{
-		if (auto it = ActorValueLookup.find(a_str); it != ActorValueLookup.end()) {
-			return it->second;
-		} else {
-			return RE::ActorValue::kNone;
-		}
+		return Find(ActorValueLookup, a_str, RE::ActorValue::kNone);
 	}
 
-	static auto LookupAxis(const std::string& a_str) -> std::int32_t
+	static auto LookupAxis(std::string_view a_str) -> std::int32_t
 	{
 		assert(a_str.empty() == false);
 		switch (std::toupper(a_str.front())) {
@@ -31,208 +35,201 @@ public:
 		}
 	}
 
-	static auto LookupCastingSource(std::string a_str)
+	static auto LookupCastingSource(std::string_view a_str)
 		-> RE::MagicSystem::CastingSource
 	{
-		Util::ToUpper(a_str);
-		if (a_str == "LEFT"s) {
-			return RE::MagicSystem::CastingSource::kLeftHand;
-		} else if (a_str == "RIGHT"s) {
-			return RE::MagicSystem::CastingSource::kRightHand;
-		} else if (a_str == "VOICE"s) {
-			return RE::MagicSystem::CastingSource::kOther;
-		} else if (a_str == "INSTANT"s) {
-			return RE::MagicSystem::CastingSource::kInstant;
-		} else {
-			return static_cast<RE::MagicSystem::CastingSource>(-1);
-		}
+		return Find(CastingSourceLookup, a_str, static_cast<RE::MagicSystem::CastingSource>(-1));
 	}
 
-	static auto LookupSex(std::string a_str) -> RE::SEX
+	static auto LookupSex(std::string_view a_str) -> RE::SEX
 	{
-		Util::ToUpper(a_str);
-		if (a_str == "MALE"s) {
-			return RE::SEX::kMale;
-		} else if (a_str == "FEMALE"s) {
-			return RE::SEX::kFemale;
-		} else {
-			return static_cast<RE::SEX>(-1);
-		}
+		return Find(SexLookup, a_str, static_cast<RE::SEX>(-1));
 	}
 
 private:
-	struct StringCmp
+	template <class V, std::size_t N>
+	static V Find(const Table<V, N>& a_table, std::string_view a_str, V a_default)
 	{
-		bool operator()(const std::string& a_lhs, const std::string& a_rhs) const
-		{
-			return _strcmpi(a_lhs.c_str(), a_rhs.c_str()) < 0;
-		}
+		const auto it = a_table.find(frozen::string{ a_str });
+		return it != a_table.end() ? it->second : a_default;
+	}
+
+	static constexpr Table<RE::MagicSystem::CastingSource, 4> CastingSourceLookup{
+		{ "LEFT", RE::MagicSystem::CastingSource::kLeftHand },
+		{ "RIGHT", RE::MagicSystem::CastingSource::kRightHand },
+		{ "VOICE", RE::MagicSystem::CastingSource::kOther },
+		{ "INSTANT", RE::MagicSystem::CastingSource::kInstant },
+	};
+
+	static constexpr Table<RE::SEX, 2> SexLookup{
+		{ "MALE", RE::SEX::kMale },
+		{ "FEMALE", RE::SEX::kFemale },
 	};
 
-	inline static const std::map<std::string, RE::ActorValue, StringCmp> ActorValueLookup{
-		{ "AGGRESSION"s, RE::ActorValue::kAggression },
-		{ "CONFIDENCE"s, RE::ActorValue::kConfidence },
-		{ "ENERGY"s, RE::ActorValue::kEnergy },
-		{ "MORALITY"s, RE::ActorValue::kMorality },
-		{ "MOOD"s, RE::ActorValue::kMood },
-		{ "ASSISTANCE"s, RE::ActorValue::kAssistance },
-		{ "ONEHANDED"s, RE::ActorValue::kOneHanded },
-		{ "TWOHANDED"s, RE::ActorValue::kTwoHanded },
-		{ "MARKSMAN"s, RE::ActorValue::kArchery },
-		{ "BLOCK"s, RE::ActorValue::kBlock },
-		{ "SMITHING"s, RE::ActorValue::kSmithing },
-		{ "HEAVYARMOR"s, RE::ActorValue::kHeavyArmor },
-		{ "LIGHTARMOR"s, RE::ActorValue::kLightArmor },
-		{ "PICKPOCKET"s, RE::ActorValue::kPickpocket },
-		{ "LOCKPICKING"s, RE::ActorValue::kLockpicking },
-		{ "SNEAK"s, RE::ActorValue::kSneak },
-		{ "ALCHEMY"s, RE::ActorValue::kAlchemy },
-		{ "SPEECHCRAFT"s, RE::ActorValue::kSpeech },
-		{ "ALTERATION"s, RE::ActorValue::kAlteration },
-		{ "CONJURATION"s, RE::ActorValue::kConjuration },
-		{ "DESTRUCTION"s, RE::ActorValue::kDestruction },
-		{ "ILLUSION"s, RE::ActorValue::kIllusion },
-		{ "RESTORATION"s, RE::ActorValue::kRestoration },
-		{ "ENCHANTING"s, RE::ActorValue::kEnchanting },
-		{ "HEALTH"s, RE::ActorValue::kHealth },
-		{ "MAGICKA"s, RE::ActorValue::kMagicka },
-		{ "STAMINA"s, RE::ActorValue::kStamina },
-		{ "HEALRATE"s, RE::ActorValue::kHealRate },
-		{ "MAGICKARATE"s, RE::ActorValue::kMagickaRate },
-		{ "STAMINARATE"s, RE::ActorValue::kStaminaRate },
-		{ "SPEEDMULT"s, RE::ActorValue::kSpeedMult },
-		{ "INVENTORYWEIGHT"s, RE::ActorValue::kInventoryWeight },
-		{ "CARRYWEIGHT"s, RE::ActorValue::kCarryWeight },
-		{ "CRITCHANCE"s, RE::ActorValue::kCriticalChance },
-		{ "MELEEDAMAGE"s, RE::ActorValue::kMeleeDamage },
-		{ "UNARMEDDAMAGE"s, RE::ActorValue::kUnarmedDamage },
-		{ "MASS"s, RE::ActorValue::kMass },
-		{ "VOICEPOINTS"s, RE::ActorValue::kVoicePoints },
-		{ "VOICERATE"s, RE::ActorValue::kVoiceRate },
-		{ "DAMAGERESIST"s, RE::ActorValue::kDamageResist },
-		{ "POISONRESIST"s, RE::ActorValue::kPoisonResist },
-		{ "FIRERESIST"s, RE::ActorValue::kResistFire },
-		{ "ELECTRICRESIST"s, RE::ActorValue::kResistShock },
-		{ "FROSTRESIST"s, RE::ActorValue::kResistFrost },
-		{ "MAGICRESIST"s, RE::ActorValue::kResistMagic },
-		{ "DISEASERESIST"s, RE::ActorValue::kResistDisease },
-		{ "PERCEPTIONCONDITION"s, RE::ActorValue::kPerceptionCondition },
-		{ "ENDURANCECONDITION"s, RE::ActorValue::kEnduranceCondition },
-		{ "LEFTATTACKCONDITION"s, RE::ActorValue::kLeftAttackCondition },
-		{ "RIGHTATTACKCONDITION"s, RE::ActorValue::kRightAttackCondition },
-		{ "LEFTMOBILITYCONDITION"s, RE::ActorValue::kLeftMobilityCondition },
-		{ "RIGHTMOBILITYCONDITION"s, RE::ActorValue::kRightMobilityCondition },
-		{ "BRAINCONDITION"s, RE::ActorValue::kBrainCondition },
-		{ "PARALYSIS"s, RE::ActorValue::kParalysis },
-		{ "INVISIBILITY"s, RE::ActorValue::kInvisibility },
-		{ "NIGHTEYE"s, RE::ActorValue::kNightEye },
-		{ "DETECTLIFERANGE"s, RE::ActorValue::kDetectLifeRange },
-		{ "WATERBREATHING"s, RE::ActorValue::kWaterBreathing },
-		{ "WATERWALKING"s, RE::ActorValue::kWaterWalking },
-		{ "IGNORECRIPPLEDLIMBS"s, RE::ActorValue::kIgnoreCrippledLimbs },
-		{ "FAME"s, RE::ActorValue::kFame },
-		{ "INFAMY"s, RE::ActorValue::kInfamy },
-		{ "JUMPINGBONUS"s, RE::ActorValue::kJumpingBonus },
-		{ "WARDPOWER"s, RE::ActorValue::kWardPower },
-		{ "RIGHTITEMCHARGE"s, RE::ActorValue::kRightItemCharge },
-		{ "ARMORPERKS"s, RE::ActorValue::kArmorPerks },
-		{ "SHIELDPERKS"s, RE::ActorValue::kShieldPerks },
-		{ "WARDDEFLECTION"s, RE::ActorValue::kWardDeflection },
-		{ "VARIABLE01"s, RE::ActorValue::kVariable01 },
-		{ "VARIABLE02"s, RE::ActorValue::kVariable02 },
-		{ "VARIABLE03"s, RE::ActorValue::kVariable03 },
-		{ "VARIABLE04"s, RE::ActorValue::kVariable04 },
-		{ "VARIABLE05"s, RE::ActorValue::kVariable05 },
-		{ "VARIABLE06"s, RE::ActorValue::kVariable06 },
-		{ "VARIABLE07"s, RE::ActorValue::kVariable07 },
-		{ "VARIABLE08"s, RE::ActorValue::kVariable08 },
-		{ "VARIABLE09"s, RE::ActorValue::kVariable09 },
-		{ "VARIABLE10"s, RE::ActorValue::kVariable10 },
-		{ "BOWSPEEDBONUS"s, RE::ActorValue::kBowSpeedBonus },
-		{ "FAVORACTIVE"s, RE::ActorValue::kFavorActive },
-		{ "FAVORSPERDAY"s, RE::ActorValue::kFavorsPerDay },
-		{ "FAVORSPERDAYTIMER"s, RE::ActorValue::kFavorsPerDayTimer },
-		{ "LEFTITEMCHARGE"s, RE::ActorValue::kLeftItemCharge },
-		{ "ABSORBCHANCE"s, RE::ActorValue::kAbsorbChance },
-		{ "BLINDNESS"s, RE::ActorValue::kBlindness },
-		{ "WEAPONSPEEDMULT"s, RE::ActorValue::kWeaponSpeedMult },
-		{ "SHOUTRECOVERYMULT"s, RE::ActorValue::kShoutRecoveryMult },
-		{ "BOWSTAGGERBONUS"s, RE::ActorValue::kBowStaggerBonus },
-		{ "TELEKINESIS"s, RE::ActorValue::kTelekinesis },
-		{ "FAVORPOINTSBONUS"s, RE::ActorValue::kFavorPointsBonus },
-		{ "LASTBRIBEDINTIMIDATED"s, RE::ActorValue::kLastBribedIntimidated },
-		{ "LASTFLATTERED"s, RE::ActorValue::kLastFlattered },
-		{ "MOVEMENTNOISEMULT"s, RE::ActorValue::kMovementNoiseMult },
-		{ "BYPASSVENDORSTOLENCHECK"s, RE::ActorValue::kBypassVendorStolenCheck },
-		{ "BYPASSVENDORKEYWORDCHECK"s, RE::ActorValue::kBypassVendorKeywordCheck },
-		{ "WAITINGFORPLAYER"s, RE::ActorValue::kWaitingForPlayer },
-		{ "ONEHANDEDMOD"s, RE::ActorValue::kOneHandedModifier },
-		{ "TWOHANDEDMOD"s, RE::ActorValue::kTwoHandedModifier },
-		{ "MARKSMANMOD"s, RE::ActorValue::kMarksmanModifier },
-		{ "BLOCKMOD"s, RE::ActorValue::kBlockModifier },
-		{ "SMITHINGMOD"s, RE::ActorValue::kSmithingModifier },
-		{ "HEAVYARMORMOD"s, RE::ActorValue::kHeavyArmorModifier },
-		{ "LIGHTARMORMOD"s, RE::ActorValue::kLightArmorModifier },
-		{ "PICKPOCKETMOD"s, RE::ActorValue::kPickpocketModifier },
-		{ "LOCKPICKINGMOD"s, RE::ActorValue::kLockpickingModifier },
-		{ "SNEAKMOD"s, RE::ActorValue::kSneakingModifier },
-		{ "ALCHEMYMOD"s, RE::ActorValue::kAlchemyModifier },
-		{ "SPEECHCRAFTMOD"s, RE::ActorValue::kSpeechcraftModifier },
-		{ "ALTERATIONMOD"s, RE::ActorValue::kAlterationModifier },
-		{ "CONJURATIONMOD"s, RE::ActorValue::kConjurationModifier },
-		{ "DESTRUCTIONMOD"s, RE::ActorValue::kDestructionModifier },
-		{ "ILLUSIONMOD"s, RE::ActorValue::kIllusionModifier },
-		{ "RESTORATIONMOD"s, RE::ActorValue::kRestorationModifier },
-		{ "ENCHANTINGMOD"s, RE::ActorValue::kEnchantingModifier },
-		{ "ONEHANDEDSKILLADVANCE"s, RE::ActorValue::kOneHandedSkillAdvance },
-		{ "TWOHANDEDSKILLADVANCE"s, RE::ActorValue::kTwoHandedSkillAdvance },
-		{ "MARKSMANSKILLADVANCE"s, RE::ActorValue::kMarksmanSkillAdvance },
-		{ "BLOCKSKILLADVANCE"s, RE::ActorValue::kBlockSkillAdvance },
-		{ "SMITHINGSKILLADVANCE"s, RE::ActorValue::kSmithingSkillAdvance },
-		{ "HEAVYARMORSKILLADVANCE"s, RE::ActorValue::kHeavyArmorSkillAdvance },
-		{ "LIGHTARMORSKILLADVANCE"s, RE::ActorValue::kLightArmorSkillAdvance },
-		{ "PICKPOCKETSKILLADVANCE"s, RE::ActorValue::kPickpocketSkillAdvance },
-		{ "LOCKPICKINGSKILLADVANCE"s, RE::ActorValue::kLockpickingSkillAdvance },
-		{ "SNEAKSKILLADVANCE"s, RE::ActorValue::kSneakingSkillAdvance },
-		{ "ALCHEMYSKILLADVANCE"s, RE::ActorValue::kAlchemySkillAdvance },
-		{ "SPEECHCRAFTSKILLADVANCE"s, RE::ActorValue::kSpeechcraftSkillAdvance },
-		{ "ALTERATIONSKILLADVANCE"s, RE::ActorValue::kAlterationSkillAdvance },
-		{ "CONJURATIONSKILLADVANCE"s, RE::ActorValue::kConjurationSkillAdvance },
-		{ "DESTRUCTIONSKILLADVANCE"s, RE::ActorValue::kDestructionSkillAdvance },
-		{ "ILLUSIONSKILLADVANCE"s, RE::ActorValue::kIllusionSkillAdvance },
-		{ "RESTORATIONSKILLADVANCE"s, RE::ActorValue::kRestorationSkillAdvance },
-		{ "ENCHANTINGSKILLADVANCE"s, RE::ActorValue::kEnchantingSkillAdvance },
-		{ "LEFTWEAPONSPEEDMULT"s, RE::ActorValue::kLeftWeaponSpeedMultiply },
-		{ "DRAGONSOULS"s, RE::ActorValue::kDragonSouls },
-		{ "COMBATHEALTHREGENMULT"s, RE::ActorValue::kCombatHealthRegenMultiply },
-		{ "ONEHANDEDPOWERMOD"s, RE::ActorValue::kOneHandedPowerModifier },
-		{ "TWOHANDEDPOWERMOD"s, RE::ActorValue::kTwoHandedPowerModifier },
-		{ "MARKSMANPOWERMOD"s, RE::ActorValue::kMarksmanPowerModifier },
-		{ "BLOCKPOWERMOD"s, RE::ActorValue::kBlockPowerModifier },
-		{ "SMITHINGPOWERMOD"s, RE::ActorValue::kSmithingPowerModifier },
-		{ "HEAVYARMORPOWERMOD"s, RE::ActorValue::kHeavyArmorPowerModifier },
-		{ "LIGHTARMORPOWERMOD"s, RE::ActorValue::kLightArmorPowerModifier },
-		{ "PICKPOCKETPOWERMOD"s, RE::ActorValue::kPickpocketPowerModifier },
-		{ "LOCKPICKINGPOWERMOD"s, RE::ActorValue::kLockpickingPowerModifier },
-		{ "SNEAKPOWERMOD"s, RE::ActorValue::kSneakingPowerModifier },
-		{ "ALCHEMYPOWERMOD"s, RE::ActorValue::kAlchemyPowerModifier },
-		{ "SPEECHCRAFTPOWERMOD"s, RE::ActorValue::kSpeechcraftPowerModifier },
-		{ "ALTERATIONPOWERMOD"s, RE::ActorValue::kAlterationPowerModifier },
-		{ "CONJURATIONPOWERMOD"s, RE::ActorValue::kConjurationPowerModifier },
-		{ "DESTRUCTIONPOWERMOD"s, RE::ActorValue::kDestructionPowerModifier },
-		{ "ILLUSIONPOWERMOD"s, RE::ActorValue::kIllusionPowerModifier },
-		{ "RESTORATIONPOWERMOD"s, RE::ActorValue::kRestorationPowerModifier },
-		{ "ENCHANTINGPOWERMOD"s, RE::ActorValue::kEnchantingPowerModifier },
-		{ "DRAGONREND"s, RE::ActorValue::kDragonRend },
-		{ "ATTACKDAMAGEMULT"s, RE::ActorValue::kAttackDamageMult },
-		{ "HEALRATEMULT"s, RE::ActorValue::kHealRateMult },
-		{ "MAGICKARATEMULT"s, RE::ActorValue::kMagickaRateMult },
-		{ "STAMINARATEMULT"s, RE::ActorValue::kStaminaRateMult },
-		{ "WEREWOLFPERKS"s, RE::ActorValue::kWerewolfPerks },
-		{ "VAMPIREPERKS"s, RE::ActorValue::kVampirePerks },
-		{ "GRABACTOROFFSET"s, RE::ActorValue::kGrabActorOffset },
-		{ "GRABBED"s, RE::ActorValue::kGrabbed },
-		{ "DEPRECATED05"s, RE::ActorValue::kDEPRECATED05 },
-		{ "REFLECTDAMAGE"s, RE::ActorValue::kReflectDamage },
+	static constexpr Table<RE::ActorValue, 164> ActorValueLookup{
+		{ "AGGRESSION", RE::ActorValue::kAggression },
+		{ "CONFIDENCE", RE::ActorValue::kConfidence },
+		{ "ENERGY", RE::ActorValue::kEnergy },
+		{ "MORALITY", RE::ActorValue::kMorality },
+		{ "MOOD", RE::ActorValue::kMood },
+		{ "ASSISTANCE", RE::ActorValue::kAssistance },
+		{ "ONEHANDED", RE::ActorValue::kOneHanded },
+		{ "TWOHANDED", RE::ActorValue::kTwoHanded },
+		{ "MARKSMAN", RE::ActorValue::kArchery },
+		{ "BLOCK", RE::ActorValue::kBlock },
+		{ "SMITHING", RE::ActorValue::kSmithing },
+		{ "HEAVYARMOR", RE::ActorValue::kHeavyArmor },
+		{ "LIGHTARMOR", RE::ActorValue::kLightArmor },
+		{ "PICKPOCKET", RE::ActorValue::kPickpocket },
+		{ "LOCKPICKING", RE::ActorValue::kLockpicking },
+		{ "SNEAK", RE::ActorValue::kSneak },
+		{ "ALCHEMY", RE::ActorValue::kAlchemy },
+		{ "SPEECHCRAFT", RE::ActorValue::kSpeech },
+		{ "ALTERATION", RE::ActorValue::kAlteration },
+		{ "CONJURATION", RE::ActorValue::kConjuration },
+		{ "DESTRUCTION", RE::ActorValue::kDestruction },
+		{ "ILLUSION", RE::ActorValue::kIllusion },
+		{ "RESTORATION", RE::ActorValue::kRestoration },
+		{ "ENCHANTING", RE::ActorValue::kEnchanting },
+		{ "HEALTH", RE::ActorValue::kHealth },
+		{ "MAGICKA", RE::ActorValue::kMagicka },
+		{ "STAMINA", RE::ActorValue::kStamina },
+		{ "HEALRATE", RE::ActorValue::kHealRate },
+		{ "MAGICKARATE", RE::ActorValue::kMagickaRate },
+		{ "STAMINARATE", RE::ActorValue::kStaminaRate },
+		{ "SPEEDMULT", RE::ActorValue::kSpeedMult },
+		{ "INVENTORYWEIGHT", RE::ActorValue::kInventoryWeight },
+		{ "CARRYWEIGHT", RE::ActorValue::kCarryWeight },
+		{ "CRITCHANCE", RE::ActorValue::kCriticalChance },
+		{ "MELEEDAMAGE", RE::ActorValue::kMeleeDamage },
+		{ "UNARMEDDAMAGE", RE::ActorValue::kUnarmedDamage },
+		{ "MASS", RE::ActorValue::kMass },
+		{ "VOICEPOINTS", RE::ActorValue::kVoicePoints },
+		{ "VOICERATE", RE::ActorValue::kVoiceRate },
+		{ "DAMAGERESIST", RE::ActorValue::kDamageResist },
+		{ "POISONRESIST", RE::ActorValue::kPoisonResist },
+		{ "FIRERESIST", RE::ActorValue::kResistFire },
+		{ "ELECTRICRESIST", RE::ActorValue::kResistShock },
+		{ "FROSTRESIST", RE::ActorValue::kResistFrost },
+		{ "MAGICRESIST", RE::ActorValue::kResistMagic },
+		{ "DISEASERESIST", RE::ActorValue::kResistDisease },
+		{ "PERCEPTIONCONDITION", RE::ActorValue::kPerceptionCondition },
+		{ "ENDURANCECONDITION", RE::ActorValue::kEnduranceCondition },
+		{ "LEFTATTACKCONDITION", RE::ActorValue::kLeftAttackCondition },
+		{ "RIGHTATTACKCONDITION", RE::ActorValue::kRightAttackCondition },
+		{ "LEFTMOBILITYCONDITION", RE::ActorValue::kLeftMobilityCondition },
+		{ "RIGHTMOBILITYCONDITION", RE::ActorValue::kRightMobilityCondition },
+		{ "BRAINCONDITION", RE::ActorValue::kBrainCondition },
+		{ "PARALYSIS", RE::ActorValue::kParalysis },
+		{ "INVISIBILITY", RE::ActorValue::kInvisibility },
+		{ "NIGHTEYE", RE::ActorValue::kNightEye },
+		{ "DETECTLIFERANGE", RE::ActorValue::kDetectLifeRange },
+		{ "WATERBREATHING", RE::ActorValue::kWaterBreathing },
+		{ "WATERWALKING", RE::ActorValue::kWaterWalking },
+		{ "IGNORECRIPPLEDLIMBS", RE::ActorValue::kIgnoreCrippledLimbs },
+		{ "FAME", RE::ActorValue::kFame },
+		{ "INFAMY", RE::ActorValue::kInfamy },
+		{ "JUMPINGBONUS", RE::ActorValue::kJumpingBonus },
+		{ "WARDPOWER", RE::ActorValue::kWardPower },
+		{ "RIGHTITEMCHARGE", RE::ActorValue::kRightItemCharge },
+		{ "ARMORPERKS", RE::ActorValue::kArmorPerks },
+		{ "SHIELDPERKS", RE::ActorValue::kShieldPerks },
+		{ "WARDDEFLECTION", RE::ActorValue::kWardDeflection },
+		{ "VARIABLE01", RE::ActorValue::kVariable01 },
+		{ "VARIABLE02", RE::ActorValue::kVariable02 },
+		{ "VARIABLE03", RE::ActorValue::kVariable03 },
+		{ "VARIABLE04", RE::ActorValue::kVariable04 },
+		{ "VARIABLE05", RE::ActorValue::kVariable05 },
+		{ "VARIABLE06", RE::ActorValue::kVariable06 },
+		{ "VARIABLE07", RE::ActorValue::kVariable07 },
+		{ "VARIABLE08", RE::ActorValue::kVariable08 },
+		{ "VARIABLE09", RE::ActorValue::kVariable09 },
+		{ "VARIABLE10", RE::ActorValue::kVariable10 },
+		{ "BOWSPEEDBONUS", RE::ActorValue::kBowSpeedBonus },
+		{ "FAVORACTIVE", RE::ActorValue::kFavorActive },
+		{ "FAVORSPERDAY", RE::ActorValue::kFavorsPerDay },
+		{ "FAVORSPERDAYTIMER", RE::ActorValue::kFavorsPerDayTimer },
+		{ "LEFTITEMCHARGE", RE::ActorValue::kLeftItemCharge },
+		{ "ABSORBCHANCE", RE::ActorValue::kAbsorbChance },
+		{ "BLINDNESS", RE::ActorValue::kBlindness },
+		{ "WEAPONSPEEDMULT", RE::ActorValue::kWeaponSpeedMult },
+		{ "SHOUTRECOVERYMULT", RE::ActorValue::kShoutRecoveryMult },
+		{ "BOWSTAGGERBONUS", RE::ActorValue::kBowStaggerBonus },
+		{ "TELEKINESIS", RE::ActorValue::kTelekinesis },
+		{ "FAVORPOINTSBONUS", RE::ActorValue::kFavorPointsBonus },
+		{ "LASTBRIBEDINTIMIDATED", RE::ActorValue::kLastBribedIntimidated },
+		{ "LASTFLATTERED", RE::ActorValue::kLastFlattered },
+		{ "MOVEMENTNOISEMULT", RE::ActorValue::kMovementNoiseMult },
+		{ "BYPASSVENDORSTOLENCHECK", RE::ActorValue::kBypassVendorStolenCheck },
+		{ "BYPASSVENDORKEYWORDCHECK", RE::ActorValue::kBypassVendorKeywordCheck },
+		{ "WAITINGFORPLAYER", RE::ActorValue::kWaitingForPlayer },
+		{ "ONEHANDEDMOD", RE::ActorValue::kOneHandedModifier },
+		{ "TWOHANDEDMOD", RE::ActorValue::kTwoHandedModifier },
+		{ "MARKSMANMOD", RE::ActorValue::kMarksmanModifier },
+		{ "BLOCKMOD", RE::ActorValue::kBlockModifier },
+		{ "SMITHINGMOD", RE::ActorValue::kSmithingModifier },
+		{ "HEAVYARMORMOD", RE::ActorValue::kHeavyArmorModifier },
+		{ "LIGHTARMORMOD", RE::ActorValue::kLightArmorModifier },
+		{ "PICKPOCKETMOD", RE::ActorValue::kPickpocketModifier },
+		{ "LOCKPICKINGMOD", RE::ActorValue::kLockpickingModifier },
+		{ "SNEAKMOD", RE::ActorValue::kSneakingModifier },
+		{ "ALCHEMYMOD", RE::ActorValue::kAlchemyModifier },
+		{ "SPEECHCRAFTMOD", RE::ActorValue::kSpeechcraftModifier },
+		{ "ALTERATIONMOD", RE::ActorValue::kAlterationModifier },
+		{ "CONJURATIONMOD", RE::ActorValue::kConjurationModifier },
+		{ "DESTRUCTIONMOD", RE::ActorValue::kDestructionModifier },
+		{ "ILLUSIONMOD", RE::ActorValue::kIllusionModifier },
+		{ "RESTORATIONMOD", RE::ActorValue::kRestorationModifier },
+		{ "ENCHANTINGMOD", RE::ActorValue::kEnchantingModifier },
+		{ "ONEHANDEDSKILLADVANCE", RE::ActorValue::kOneHandedSkillAdvance },
+		{ "TWOHANDEDSKILLADVANCE", RE::ActorValue::kTwoHandedSkillAdvance },
+		{ "MARKSMANSKILLADVANCE", RE::ActorValue::kMarksmanSkillAdvance },
+		{ "BLOCKSKILLADVANCE", RE::ActorValue::kBlockSkillAdvance },
+		{ "SMITHINGSKILLADVANCE", RE::ActorValue::kSmithingSkillAdvance },
+		{ "HEAVYARMORSKILLADVANCE", RE::ActorValue::kHeavyArmorSkillAdvance },
+		{ "LIGHTARMORSKILLADVANCE", RE::ActorValue::kLightArmorSkillAdvance },
+		{ "PICKPOCKETSKILLADVANCE", RE::ActorValue::kPickpocketSkillAdvance },
+		{ "LOCKPICKINGSKILLADVANCE", RE::ActorValue::kLockpickingSkillAdvance },
+		{ "SNEAKSKILLADVANCE", RE::ActorValue::kSneakingSkillAdvance },
+		{ "ALCHEMYSKILLADVANCE", RE::ActorValue::kAlchemySkillAdvance },
+		{ "SPEECHCRAFTSKILLADVANCE", RE::ActorValue::kSpeechcraftSkillAdvance },
+		{ "ALTERATIONSKILLADVANCE", RE::ActorValue::kAlterationSkillAdvance },
+		{ "CONJURATIONSKILLADVANCE", RE::ActorValue::kConjurationSkillAdvance },
+		{ "DESTRUCTIONSKILLADVANCE", RE::ActorValue::kDestructionSkillAdvance },
+		{ "ILLUSIONSKILLADVANCE", RE::ActorValue::kIllusionSkillAdvance },
+		{ "RESTORATIONSKILLADVANCE", RE::ActorValue::kRestorationSkillAdvance },
+		{ "ENCHANTINGSKILLADVANCE", RE::ActorValue::kEnchantingSkillAdvance },
+		{ "LEFTWEAPONSPEEDMULT", RE::ActorValue::kLeftWeaponSpeedMultiply },
+		{ "DRAGONSOULS", RE::ActorValue::kDragonSouls },
+		{ "COMBATHEALTHREGENMULT", RE::ActorValue::kCombatHealthRegenMultiply },
+		{ "ONEHANDEDPOWERMOD", RE::ActorValue::kOneHandedPowerModifier },
+		{ "TWOHANDEDPOWERMOD", RE::ActorValue::kTwoHandedPowerModifier },
+		{ "MARKSMANPOWERMOD", RE::ActorValue::kMarksmanPowerModifier },
+		{ "BLOCKPOWERMOD", RE::ActorValue::kBlockPowerModifier },
+		{ "SMITHINGPOWERMOD", RE::ActorValue::kSmithingPowerModifier },
+		{ "HEAVYARMORPOWERMOD", RE::ActorValue::kHeavyArmorPowerModifier },
+		{ "LIGHTARMORPOWERMOD", RE::ActorValue::kLightArmorPowerModifier },
+		{ "PICKPOCKETPOWERMOD", RE::ActorValue::kPickpocketPowerModifier },
+		{ "LOCKPICKINGPOWERMOD", RE::ActorValue::kLockpickingPowerModifier },
+		{ "SNEAKPOWERMOD", RE::ActorValue::kSneakingPowerModifier },
+		{ "ALCHEMYPOWERMOD", RE::ActorValue::kAlchemyPowerModifier },
+		{ "SPEECHCRAFTPOWERMOD", RE::ActorValue::kSpeechcraftPowerModifier },
+		{ "ALTERATIONPOWERMOD", RE::ActorValue::kAlterationPowerModifier },
+		{ "CONJURATIONPOWERMOD", RE::ActorValue::kConjurationPowerModifier },
+		{ "DESTRUCTIONPOWERMOD", RE::ActorValue::kDestructionPowerModifier },
+		{ "ILLUSIONPOWERMOD", RE::ActorValue::kIllusionPowerModifier },
+		{ "RESTORATIONPOWERMOD", RE::ActorValue::kRestorationPowerModifier },
+		{ "ENCHANTINGPOWERMOD", RE::ActorValue::kEnchantingPowerModifier },
+		{ "DRAGONREND", RE::ActorValue::kDragonRend },
+		{ "ATTACKDAMAGEMULT", RE::ActorValue::kAttackDamageMult },
+		{ "HEALRATEMULT", RE::ActorValue::kHealRateMult },
+		{ "MAGICKARATEMULT", RE::ActorValue::kMagickaRateMult },
+		{ "STAMINARATEMULT", RE::ActorValue::kStaminaRateMult },
+		{ "WEREWOLFPERKS", RE::ActorValue::kWerewolfPerks },
+		{ "VAMPIREPERKS", RE::ActorValue::kVampirePerks },
+		{ "GRABACTOROFFSET", RE::ActorValue::kGrabActorOffset },
+		{ "GRABBED", RE::ActorValue::kGrabbed },
+		{ "DEPRECATED05", RE::ActorValue::kDEPRECATED05 },
+		{ "REFLECTDAMAGE", RE::ActorValue::kReflectDamage },
 	};
 };
\ No newline at end of file
@@ -0,0 +1,19 @@
+#include "NativeConditions.h"
+
+namespace Conditions
+{
+	bool NativeConditions::Register(std::string_view a_name, Function a_function)
+	{
+		std::unique_lock lock{ _lock };
+		return _functions.try_emplace(std::string{ a_name }, a_function).second;
+	}
+
+	std::optional<NativeConditions::Function> NativeConditions::Find(std::string_view a_name)
+	{
+		std::unique_lock lock{ _lock };
+		if (const auto where = _functions.find(a_name); where != _functions.end()) {
+			return where->second;
+		}
+		return std::nullopt;
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "API/DDRAPI.h"
+#include "Util/StringUtil.h"
+
+namespace Conditions
+{
+	/// @brief Condition functions registered by other plugins through the native interface
+	class NativeConditions
+	{
+	public:
+		struct Function
+		{
+			DDR_ConditionFn function;
+			void* user;
+
+			_NODISCARD float operator()(RE::TESObjectREFR* a_subject, RE::TESObjectREFR* a_target) const { return function(user, a_subject, a_target); }
+		};
+
+		NativeConditions() = delete;
+
+		/// @brief Prefix which marks a raw condition as a native one
+		static constexpr std::string_view PREFIX = "Native";
+
+		/// @return false if a function is already registered under a_name
+		static bool Register(std::string_view a_name, Function a_function);
+		static std::optional<Function> Find(std::string_view a_name);
+
+	private:
+		static inline std::unordered_map<std::string, Function, Util::CaseInsensitiveHash, Util::CaseInsensitiveEqual> _functions{};
+		static inline std::mutex _lock{};
+	};
+}
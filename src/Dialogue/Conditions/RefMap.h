@@ -1,34 +1,68 @@
 #pragma once
 
 #include "Util/FormLookup.h"
+#include "Util/StringUtil.h"
 
 namespace Conditions
 {
-	class RefMap
+	/// @brief Resolves form strings ("0x123|Plugin.esp", editor ids) for an entire load
+	/// Every result is cached case-insensitively, including failed resolutions
+	class RefResolver
 	{
-		struct StringCmp
+		template <class V>
+		using Map = std::unordered_map<std::string, V, Util::CaseInsensitiveHash, Util::CaseInsensitiveEqual>;
+
+	public:
+		RefResolver()
+		{
+			_cache.emplace("player", RE::PlayerCharacter::GetSingleton());
+		}
+
+		RE::TESForm* Resolve(const std::string& a_key)
 		{
-			bool operator()(const std::string& a_lhs, const std::string& a_rhs) const
-			{
-				return _strcmpi(a_lhs.c_str(), a_rhs.c_str()) < 0;
+			// conditions are parsed lazily, possibly from several threads at once
+			std::unique_lock lock{ _lock };
+			_lookups++;
+			if (const auto where = _cache.find(a_key); where != _cache.end()) {
+				_hits++;
+				return where->second;
+			}
+			auto ref = Util::FormFromString<RE::TESForm>(a_key);
+			if (!ref) {
+				ref = RE::TESForm::LookupByEditorID(a_key);
 			}
-		};
+			_cache.emplace(a_key, ref);
+			return ref;
+		}
+
+		_NODISCARD size_t GetLookups() const { return _lookups; }
+		_NODISCARD size_t GetCacheHits() const { return _hits; }
+		_NODISCARD size_t size() const { return _cache.size(); }
+
+	private:
+		std::mutex _lock{};
+		Map<RE::TESForm*> _cache{};
+		size_t _lookups{ 0 };
+		size_t _hits{ 0 };
+	};
 
-		std::map<std::string, RE::TESForm*, StringCmp> refMap;
+	/// @brief The aliases of a single file, layered over the load-wide resolver
+	/// Always owned by a shared_ptr, lazily parsed conditions keep the map of their file alive
+	class RefMap :
+		public std::enable_shared_from_this<RefMap>
+	{
+		std::unordered_map<std::string, RE::TESForm*, Util::CaseInsensitiveHash, Util::CaseInsensitiveEqual> refMap;
+		std::shared_ptr<RefResolver> resolver;
 
 	public:
 		template <typename T = RE::TESForm>
 		T* Lookup(const std::string& a_key) const
 		{
-			if (refMap.contains(a_key)) {
-				const auto ret = refMap.at(a_key);
-				return ret->As<T>();
-			}
-			auto ref = Util::FormFromString<T>(a_key);
-			if (!ref) {
-				ref = RE::TESForm::LookupByEditorID<T>(a_key);
+			if (const auto where = refMap.find(a_key); where != refMap.end()) {
+				return where->second->As<T>();
 			}
-			return ref;
+			const auto ref = resolver->Resolve(a_key);
+			return ref ? ref->As<T>() : nullptr;
 		}
 
 		RE::FormID LookupId(const std::string& a_key) const
@@ -45,12 +79,12 @@ namespace Conditions
 		}
 
 	public:
-		RefMap(const std::map<std::string, std::string>& a_rawRefs)
+		RefMap(const std::map<std::string, std::string>& a_rawRefs, std::shared_ptr<RefResolver> a_resolver) :
+			resolver(std::move(a_resolver))
 		{
 			if (a_rawRefs.size() > 0) {
 				logger::info("Loading reference map ({} raw entries)", a_rawRefs.size());
 			}
-			refMap["player"] = RE::PlayerCharacter::GetSingleton();
 			for (const auto& [key, refStr] : a_rawRefs) {
 				if (auto ref = Lookup<RE::TESForm>(refStr)) {
 					refMap[key] = ref;
@@ -62,4 +96,4 @@ namespace Conditions
 		~RefMap() = default;
 	};
 
-}	 // namespace Conditions
\ No newline at end of file
+}	 // namespace Conditions
@@ -1,17 +1,32 @@
 #include "DialogueManager.h"
 
 #include "Conditions/RefMap.h"
+#include "DialogueSession.h"
+#include "LoadProfiler.h"
+#include "ReplacementFile.h"
+#include "Settings.h"
+#include "Stats.h"
 #include "Util/Random.h"
 
 namespace DDR
 {	
-	void DialogueManager::Init()
+	void DialogueManager::StartPreload()
 	{
-		logger::info("Initializing replacements");
+		if (!Settings::preload || _preload.valid()) {
+			return;
+		}
+		logger::info("Preloading replacements");
+		_preload = std::async(std::launch::async, &DialogueManager::LoadFiles);
+	}
+
+	DialogueManager::Preload DialogueManager::LoadFiles()
+	{
+		Preload ret{ .begin = std::chrono::steady_clock::now() };
 		std::error_code ec{};
 		if (!fs::exists(DIRECTORY_PATH, ec) || fs::is_empty(DIRECTORY_PATH, ec)) {
 			logger::error("Error loading replacements in {}. Folder is empty or does not exist - {}", DIRECTORY_PATH, ec.message());
-			return;
+			ret.end = std::chrono::steady_clock::now();
+			return ret;
 		}
 		for (const auto& entry : fs::directory_iterator(DIRECTORY_PATH)) {
 			if (entry.is_directory())
@@ -21,97 +36,227 @@ namespace DDR
 				continue;
 			}
 			const std::string fileName = entry.path().string();
+			auto& profile = ret.profiler.BeginFile(fileName);
+			const auto size = entry.file_size(ec);
+			profile.bytes = ec ? 0 : static_cast<size_t>(size);
+			auto& file = ret.files.emplace_back(fileName);
+			try {
+				logger::info("Reading file {}", fileName);
+				auto& contents = file.contents.emplace(profile.Measure(LoadProfiler::Phase::Read, [&] {
+					return Settings::streamingLoader ? ReplacementFile::Stream(entry.path()) : ReplacementFile::Load(entry.path());
+				}));
+				profile.conditions = contents.GetConditionCount();
+				profile.Measure(LoadProfiler::Phase::Compile, [&] {
+					for (const auto& record : contents.scripts) {
+						const auto& script = record.data.script;
+						if (script.empty() || ret.bytecode.contains(script)) {
+							continue;
+						}
+						try {
+							ret.bytecode.emplace(script, LuaData::CompileScript(std::format("{}/{}", SCRIPT_PATH, script)));
+						} catch (std::exception&) {
+							// loaded from source instead, which reports the error
+						}
+					}
+				});
+			} catch (std::exception& e) {
+				profile.failed = true;
+				file.contents.reset();
+				logger::info("Failed to load {} - {}", fileName, e.what());
+			}
+			ret.profiler.EndFile();
+		}
+		ret.end = std::chrono::steady_clock::now();
+		return ret;
+	}
+
+	void DialogueManager::Init()
+	{
+		logger::info("Initializing replacements");
+		// handles kept by scripts from an earlier launch must not match the handles of this one
+		_nextTempHandle = std::random_device{}();
+		const auto dataLoaded = std::chrono::steady_clock::now();
+		const bool preloaded = _preload.valid();
+		auto preload = preloaded ? _preload.get() : LoadFiles();
+		auto& profiler = preload.profiler;
+		if (preloaded) {
+			profiler.Add(LoadProfiler::Stage::Wait, std::chrono::steady_clock::now() - dataLoaded);
+			profiler.SetOverlap(std::min(preload.end, dataLoaded) - preload.begin);
+		}
+		std::vector<SourceFile> files{};
+		const auto resolver = std::make_shared<Conditions::RefResolver>();
+		for (size_t i = 0; i < preload.files.size(); i++) {
+			auto& [fileName, contents] = preload.files[i];
+			files.emplace_back(fileName, static_cast<Handle>(_responses.size()), static_cast<Handle>(_topics.size()));
+			if (!contents) {
+				continue;
+			}
+			auto& profile = profiler.ResumeFile(i);
 			try {
 				logger::info("Loading file {}", fileName);
-				const auto file = YAML::LoadFile(fileName);
-				const auto refs = file["refMap"].as<std::map<std::string, std::string>>(std::map<std::string, std::string>{});
-				const Conditions::RefMap refMap{ refs };
-				size_t responses = ParseResponses(file, refMap);
-				size_t topics = ParseTopics(file, refMap);
-				size_t scripts = ParseScripts(file);
-				logger::info("Loaded {} response replacements, {} topic replacements and {} scripts from {}", responses, topics, scripts, fileName);
+				const auto refMap = profile.Measure(LoadProfiler::Phase::RefMap, [&] { return std::make_shared<const Conditions::RefMap>(contents->refMap, resolver); });
+				profile.responses = profile.Measure(LoadProfiler::Phase::Responses, [&] { return ParseResponses(*contents, *refMap); });
+				profile.topics = profile.Measure(LoadProfiler::Phase::Topics, [&] { return ParseTopics(*contents, *refMap); });
+				profile.scripts = profile.Measure(LoadProfiler::Phase::Scripts, [&] { return ParseScripts(*contents, preload.bytecode); });
+				logger::info("Loaded {} response replacements, {} topic replacements and {} scripts from {}", profile.responses, profile.topics, profile.scripts, fileName);
 			} catch (std::exception& e) {
+				profile.failed = true;
 				logger::info("Failed to load {} - {}", fileName, e.what());
 			}
+			profiler.EndFile();
+			contents.reset();
+		}
+		logger::info("Resolved {} form references, {} distinct, {} served from cache", resolver->GetLookups(), resolver->size(), resolver->GetCacheHits());
+		std::vector<RE::FormID> keys{};
+		profiler.Measure(LoadProfiler::Stage::Bind, [&] { BindReplacements(files, keys); });
+		profiler.Measure(LoadProfiler::Stage::Filter, [&] {
+			std::ranges::sort(keys);
+			const auto [first, last] = std::ranges::unique(keys);
+			keys.erase(first, last);
+			_replacementFilter.Build(keys);
+		});
+		logger::info("Built replacement filter over {} forms, {} bytes, estimated false positive rate {:.4f}%",
+			keys.size(), _replacementFilter.GetMemoryUsage(), 100.0 * _replacementFilter.FalsePositiveRate());
+		profiler.Measure(LoadProfiler::Stage::Pipelines, [&] { _lua.BuildPipelines(); });
+		_luaWorkers.Start(Settings::luaWorkers);
+		profiler.Measure(LoadProfiler::Stage::Sort, [&] {
+			// entries reference records by address, stores must not reallocate past this point
+			_responses.shrink_to_fit();
+			_topics.shrink_to_fit();
+			_responseReplacements.Finalize(_responses);
+			_topicReplacements.Finalize(_topics);
+			_topicReplacementOrphans.Finalize(_topics);
+		});
+		profiler.Report(Settings::loadReportSize);
+		_ready = true;
+		if (Settings::backgroundCompile) {
+			CompileInBackground();
 		}
-		auto sortByPriority = [](auto& map) {
-			for (auto& [_, vec] : map) {
-				std::ranges::sort(vec, [](const auto& a, const auto& b) { return a->GetPriority() > b->GetPriority(); });
+	}
+
+	void DialogueManager::CompileInBackground()
+	{
+		_compiler = std::jthread([this](std::stop_token a_stop) {
+			const auto start = std::chrono::steady_clock::now();
+			for (Handle i = 0; i < _responses.size() && !a_stop.stop_requested(); i++) {
+				_responses[i].GetConditions().Compile();
 			}
-		};
-		sortByPriority(_topicReplacements);
-		sortByPriority(_topicReplacementOrphans);
-		sortByPriority(_responseReplacements);
+			for (Handle i = 0; i < _topics.size() && !a_stop.stop_requested(); i++) {
+				_topics[i].GetConditions().Compile();
+			}
+			const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+			logger::info("Compiled conditions of {} replacements in the background in {}ms", _responses.size() + _topics.size(), elapsed.count());
+		});
 	}
 	
-	size_t DialogueManager::ParseResponses(const YAML::Node& a_node, const Conditions::RefMap& a_refMap)
+	size_t DialogueManager::ParseResponses(ReplacementFile& a_file, const Conditions::RefMap& a_refMap)
 	{
-		const auto node = a_node["topicInfos"];
-		if (!node.IsDefined() || !node.IsSequence()) {
+		if (a_file.topicInfos.empty()) {
 			return 0;
 		}
 		logger::info("Loading TopicInfo replacements");
 		size_t responses = 0;
-		for (const auto&& it : node) {
+		for (auto& [data, line] : a_file.topicInfos) {
 			try {
-				const auto repl = std::make_shared<TopicInfo>(it, a_refMap);
-				for (const auto& hash : repl->GetHashes()) {
-					_responseReplacements[hash].emplace_back(repl);
-				}
+				_responses.Insert(TopicInfo{ std::move(data), a_refMap });
 				responses++;
 			} catch (std::exception& e) {
-				logger::info("Line {}: Failed to load response replacement - {}", 1 + it.Mark().line, e.what());
+				logger::info("Line {}: Failed to load response replacement - {}", 1 + line, e.what());
 			}
 		}
 		return responses;
 	}
 
-	size_t DialogueManager::ParseTopics(const YAML::Node& a_node, const Conditions::RefMap& a_refMap)
+	size_t DialogueManager::ParseTopics(ReplacementFile& a_file, const Conditions::RefMap& a_refMap)
 	{
-		const auto node = a_node["topics"];
-		if (!node.IsDefined() || !node.IsSequence()) {
+		if (a_file.topics.empty()) {
 			return 0;
 		}
 		logger::info("Loading Topic replacements");
 		size_t topics = 0;
-		for (const auto&& it : node) {
+		for (auto& [data, line] : a_file.topics) {
 			try {
-				const auto repl = std::make_shared<Topic>(it, a_refMap);
-				if (auto id = repl->GetId(); id != 0) {
-					_topicReplacements[id].emplace_back(repl);
-				} else {
-					_topicReplacementOrphans[repl->GetAffectedTopic()].emplace_back(repl);
-				}
+				_topics.Insert(Topic{ std::move(data), a_refMap });
 				topics++;
 			} catch (std::exception& e) {
-				logger::info("Line {}: Failed to load topic replacement - {}", 1 + it.Mark().line, e.what());
+				logger::info("Line {}: Failed to load topic replacement - {}", 1 + line, e.what());
 			}
 		}
 		return topics;
 	}
 
-	size_t DialogueManager::ParseScripts(const YAML::Node& a_node)
+	size_t DialogueManager::ParseScripts(ReplacementFile& a_file, const std::unordered_map<std::string, std::string>& a_bytecode)
 	{
-		const auto node = a_node["scripts"];
-		if (!node.IsDefined() || !node.IsSequence()) {
-			return 0;
-		}
 		size_t scripts = 0;
-		for (const auto&& it : node) {
+		for (auto& [data, line] : a_file.scripts) {
 			try {
-				TextReplacement repl{ it };
-				if (!_lua.InitializeEnvironment(repl)) {
-					logger::info("Line {}: Failed to initialize environment for script {}", 1 + it.Mark().line, repl.GetScript());
-				} else {
-					scripts++;
+				TextReplacement repl{ std::move(data) };
+				const auto bytecode = a_bytecode.find(std::string{ repl.GetScript() });
+				const auto code = bytecode != a_bytecode.end() ? std::string_view{ bytecode->second } : std::string_view{};
+				if (!_lua.InitializeEnvironment(repl, code)) {
+					logger::info("Line {}: Failed to initialize environment for script {}", 1 + line, repl.GetScript());
+					continue;
+				}
+				if (repl.IsPure()) {
+					_luaWorkers.AddScript(repl, std::string{ code });
 				}
+				scripts++;
 			} catch (std::exception& e) {
-				logger::info("Line {}: Failed to load script - {}", 1 + it.Mark().line, e.what());
+				logger::info("Line {}: Failed to load script - {}", 1 + line, e.what());
 			}
 		}
 		return scripts;
 	}
 
+	void DialogueManager::BindReplacements(const std::vector<SourceFile>& a_files, std::vector<RE::FormID>& a_keys)
+	{
+		logger::info("Binding form references");
+		size_t numUnresolved = 0;
+		std::vector<std::pair<std::string_view, std::vector<std::string>>> report{};
+		for (size_t i = 0; i < a_files.size(); i++) {
+			const auto& file = a_files[i];
+			const bool last = i + 1 == a_files.size();
+			const auto responsesEnd = last ? static_cast<Handle>(_responses.size()) : a_files[i + 1].responses;
+			const auto topicsEnd = last ? static_cast<Handle>(_topics.size()) : a_files[i + 1].topics;
+			std::vector<std::string> unresolved{};
+			for (auto handle = file.responses; handle < responsesEnd; handle++) {
+				auto& repl = _responses[handle];
+				if (!repl.Bind(unresolved))
+					continue;
+				for (const auto& hash : repl.GetHashes()) {
+					_responseReplacements.Stage(hash, handle);
+				}
+				a_keys.push_back(repl.GetId());
+			}
+			for (auto handle = file.topics; handle < topicsEnd; handle++) {
+				auto& repl = _topics[handle];
+				if (!repl.Bind(unresolved))
+					continue;
+				if (const auto id = repl.GetId(); id != 0) {
+					_topicReplacements.Stage(id, handle);
+					a_keys.push_back(id);
+				} else {
+					_topicReplacementOrphans.Stage(repl.GetAffectedTopic(), handle);
+					a_keys.push_back(repl.GetAffectedTopic());
+				}
+			}
+			if (!unresolved.empty()) {
+				numUnresolved += unresolved.size();
+				report.emplace_back(file.name, std::move(unresolved));
+			}
+		}
+		if (report.empty()) {
+			logger::info("All form references resolved");
+			return;
+		}
+		logger::warn("Validation report: {} unresolved references in {} files", numUnresolved, report.size());
+		for (const auto& [file, unresolved] : report) {
+			logger::warn("{}:", file);
+			for (const auto& ref : unresolved) {
+				logger::warn("\t{}", ref);
+			}
+		}
+	}
 
 	RE::TESObjectREFR* DialogueManager::GetDialogueTarget(RE::Actor* a_speaker)
 	{
@@ -123,258 +268,413 @@ namespace DDR
 		return nullptr;
 	}
 
-	std::shared_ptr<TopicInfo> DialogueManager::FindReplacementResponse(RE::Character* a_speaker, RE::TESTopicInfo* a_topicInfo, RE::TESTopicInfo::ResponseData*)
+	const TopicInfo* DialogueManager::FindReplacementResponse(RE::Character* a_speaker, RE::TESTopicInfo* a_topicInfo, RE::TESTopicInfo::ResponseData*)
+	{
+		if (!a_topicInfo || !a_speaker || !_ready) {
+			return nullptr;
+		}
+		const auto base = a_speaker->GetActorBase();
+		return FindReplacementResponse(a_speaker, GetDialogueTarget(a_speaker), base ? base->GetVoiceType() : nullptr, a_topicInfo);
+	}
+
+	const TopicInfo* DialogueManager::FindReplacementResponse(const DialogueSession& a_session, RE::TESTopicInfo* a_topicInfo)
+	{
+		const auto speaker = a_session.GetSpeaker();
+		const auto character = speaker ? speaker->As<RE::Character>() : nullptr;
+		if (!a_topicInfo || !character || !_ready) {
+			return nullptr;
+		}
+		return FindReplacementResponse(character, a_session.GetTarget(), a_session.GetVoiceType(), a_topicInfo);
+	}
+
+	const TopicInfo* DialogueManager::FindReplacementResponse(const DialogueSession& a_session, const PreparedResponse& a_prepared)
 	{
-		if (!a_topicInfo || !a_speaker) {
+		const auto speaker = a_session.GetSpeaker();
+		const auto character = speaker ? speaker->As<RE::Character>() : nullptr;
+		if (!character || !_ready) {
+			return nullptr;
+		}
+		// account for the lookup now, as if it had not been prepared
+		if (a_prepared.filtered) {
+			Stats::Add(Stats::filterRejected);
 			return nullptr;
 		}
+		Stats::Add(Stats::filterPassed);
+		if (a_prepared.entries.empty()) {
+			Stats::Add(Stats::filterFalsePositives);
+			return nullptr;
+		}
+		return PickResponse(a_prepared.entries, character, a_session.GetTarget());
+	}
+
+	const TopicInfo* DialogueManager::FindReplacementResponse(RE::Character* a_speaker, RE::TESObjectREFR* a_target, RE::BGSVoiceType* a_voiceType, RE::TESTopicInfo* a_topicInfo)
+	{
+		if (!_replacementFilter.MayContain(a_topicInfo->GetFormID())) {
+			Stats::Add(Stats::filterRejected);
+			return nullptr;
+		}
+		Stats::Add(Stats::filterPassed);
 		// regular convo between actors
+		if (!a_voiceType) {
+			return nullptr;
+		}
+		const auto replacements = FindResponseEntries(a_topicInfo, a_voiceType);
+		if (replacements.empty()) {
+			Stats::Add(Stats::filterFalsePositives);
+			return nullptr;
+		}
+		return PickResponse(replacements, a_speaker, a_target);
+	}
+
+	const TopicInfo* DialogueManager::PeekReplacementResponse(RE::Character* a_speaker, RE::TESTopicInfo* a_topicInfo) const
+	{
+		if (!a_topicInfo || !a_speaker || !_ready || !_replacementFilter.MayContain(a_topicInfo->GetFormID())) {
+			return nullptr;
+		}
 		const auto base = a_speaker->GetActorBase();
 		const auto voiceType = base ? base->GetVoiceType() : nullptr;
 		if (!voiceType) {
 			return nullptr;
 		}
-		RE::TESObjectREFR* target = GetDialogueTarget(a_speaker);
-		// try stored overrides next
-		const auto key = TopicInfo::GenerateHash(a_topicInfo->GetFormID(), voiceType);
-		auto iter = _responseReplacements.find(key);
-		if (iter == _responseReplacements.end()) {
-			const auto allKey = TopicInfo::GenerateHash(a_topicInfo->GetFormID());
-			iter = _responseReplacements.find(allKey);
-		}
-		if (iter != _responseReplacements.end()) {
-			const auto& replacements = iter->second;
-			std::vector<std::shared_ptr<TopicInfo>> candidates;
-			for (const auto& repl : replacements) {
-				const auto rand = repl->IsRandom();
-				if ((candidates.empty() || (rand && repl->GetPriority() >= candidates[0]->GetPriority())) && repl->ConditionsMet(a_speaker, target)) {
-					if (rand) {
-						candidates.push_back(repl);
-					} else {
-						return repl;
+		// entries are sorted by priority, so the first match is what PickResponse returns or draws among
+		const auto target = GetDialogueTarget(a_speaker);
+		for (const auto& entry : FindResponseEntries(a_topicInfo, voiceType)) {
+			if (entry.ConditionsMet(a_speaker, target)) {
+				return std::addressof(_responses[entry.handle]);
+			}
+		}
+		return nullptr;
+	}
+
+	std::span<const Entry> DialogueManager::FindResponseEntries(RE::TESTopicInfo* a_topicInfo, RE::BGSVoiceType* a_voiceType) const
+	{
+		const auto key = TopicInfo::GenerateHash(a_topicInfo->GetFormID(), a_voiceType);
+		const auto replacements = _responseReplacements.Find(key);
+		if (!replacements.empty()) {
+			return replacements;
+		}
+		return _responseReplacements.Find(TopicInfo::GenerateHash(a_topicInfo->GetFormID()));
+	}
+
+	const TopicInfo* DialogueManager::PickResponse(std::span<const Entry> a_entries, RE::Character* a_speaker, RE::TESObjectREFR* a_target)
+	{
+		// entries are sorted by priority, random candidates share the priority of the first match
+		const Entry* chosen = nullptr;
+		size_t candidates = 0;
+		for (const auto& entry : a_entries) {
+			if (candidates > 0) {
+				if (entry.priority < chosen->priority)
+					break;
+				if (!entry.IsRandom())
+					continue;
+			}
+			if (!entry.ConditionsMet(a_speaker, a_target)) {
+				continue;
+			}
+			if (!entry.IsRandom()) {
+				return std::addressof(_responses[entry.handle]);
+			}
+			// reservoir sampling, each candidate ends up with equal probability
+			if (Random::draw<size_t>(0, candidates++) == 0) {
+				chosen = std::addressof(entry);
+			}
+		}
+		return chosen ? std::addressof(_responses[chosen->handle]) : nullptr;
+	}
+
+	void DialogueManager::PrepareResponses(RE::Character* a_speaker, std::span<RE::TESTopicInfo* const> a_topicInfos)
+	{
+		if (!a_speaker || !_ready) {
+			return;
+		}
+		uint32_t epoch;
+		{
+			std::unique_lock lock{ _preparedMutex };
+			epoch = _preparedEpoch;
+		}
+		const auto base = a_speaker->GetActorBase();
+		const auto voiceType = base ? base->GetVoiceType() : nullptr;
+		if (!voiceType) {
+			return;
+		}
+		// only lookups without side effects: conditions, random draws and statistics wait until a topic is picked
+		std::vector<PreparedResponse> prepared{};
+		prepared.reserve(a_topicInfos.size());
+		for (const auto topicInfo : a_topicInfos) {
+			if (!topicInfo) {
+				continue;
+			}
+			auto& entry = prepared.emplace_back(topicInfo, a_speaker, voiceType, epoch);
+			entry.filtered = !_replacementFilter.MayContain(topicInfo->GetFormID());
+			if (entry.filtered) {
+				continue;
+			}
+			entry.entries = FindResponseEntries(topicInfo, voiceType);
+			entry.candidates.reserve(entry.entries.size());
+			for (const auto& candidate : entry.entries) {
+				auto& [response, voicePaths] = entry.candidates.emplace_back(std::addressof(_responses[candidate.handle]));
+				const auto count = response->GetResponseCount();
+				voicePaths.resize(count);
+				for (int i = 1; i <= count; i++) {
+					if (response->HasReplacementVoiceFile(i)) {
+						voicePaths[i - 1] = response->GetVoiceFilePath(topicInfo->parentTopic, topicInfo, voiceType, i);
 					}
 				}
 			}
-			if (!candidates.empty()) {
-				return candidates[Random::draw<size_t>(0, candidates.size() - 1)];
-			}
 		}
-		return nullptr;
+		Stats::Add(Stats::responsesPrepared, prepared.size());
+		std::unique_lock lock{ _preparedMutex };
+		if (epoch == _preparedEpoch) {
+			_preparedResponses = std::move(prepared);
+		}
+	}
+
+	std::optional<PreparedResponse> DialogueManager::TakePreparedResponse(RE::Character* a_speaker, RE::TESTopicInfo* a_topicInfo)
+	{
+		std::unique_lock lock{ _preparedMutex };
+		const auto where = std::ranges::find_if(_preparedResponses, [&](const PreparedResponse& a_prepared) {
+			return a_prepared.topicInfo == a_topicInfo && a_prepared.speaker == a_speaker && a_prepared.epoch == _preparedEpoch;
+		});
+		if (where == _preparedResponses.end()) {
+			return std::nullopt;
+		}
+		auto ret = std::move(*where);
+		// saying the line may change what the remaining topics resolve to
+		_preparedEpoch++;
+		_preparedResponses.clear();
+		return ret;
+	}
+
+	void DialogueManager::InvalidatePreparedResponses()
+	{
+		std::unique_lock lock{ _preparedMutex };
+		_preparedEpoch++;
+		_preparedResponses.clear();
 	}
 
-	std::vector<std::shared_ptr<Topic>> DialogueManager::FindReplacementTopic(RE::FormID a_parentId, RE::FormID a_topicId, RE::TESObjectREFR* a_target, bool a_preprocessing)
+	TopicReplacements DialogueManager::FindReplacementTopic(RE::FormID a_parentId, RE::FormID a_topicId, RE::TESObjectREFR* a_target, bool a_preprocessing)
 	{
-		std::vector<std::shared_ptr<Topic>> ret{};
-		if (_tempTopicMutex.try_lock()) {
-			if (_tempTopicKeys.contains(a_parentId)) {
-				ret.push_back(_tempTopicReplacements[a_parentId]);
+		TopicReplacements ret{};
+		if (!_ready) {
+			return ret;
+		}
+		const bool mayHaveStatic = _replacementFilter.MayContain(a_parentId) || _replacementFilter.MayContain(a_topicId);
+		if (!mayHaveStatic && _tempTopicCount == 0) {
+			Stats::Add(Stats::filterRejected);
+			return ret;
+		}
+		if (_tempTopicCount > 0 && _tempTopicMutex.try_lock()) {
+			if (const auto where = _tempTopicReplacements.find(a_parentId); where != _tempTopicReplacements.end()) {
+				ret.temporary = where->second.topic;
+				ret.topics.push_back(ret.temporary.get());
 			}
 			_tempTopicMutex.unlock();
 		}
 		const auto player = RE::PlayerCharacter::GetSingleton();
-		const auto append = [&](const auto& topicMap, const auto findId) {
-			auto iter = topicMap.find(findId);
-			if (iter == topicMap.end())
-				return;
-			const auto& replacements = iter->second;
-			for (const auto& repl : replacements) {
-				if (a_preprocessing && !repl->HasPreProcessingAction())
+		const auto append = [&](const auto& a_index, const auto a_findId) {
+			for (const auto& entry : a_index.Find(a_findId)) {
+				if (a_preprocessing && !entry.HasPreProcessingAction())
 					continue;
-				if (repl->ConditionsMet(a_target, player)) {
-					ret.push_back(repl);
+				if (entry.ConditionsMet(a_target, player)) {
+					ret.topics.push_back(std::addressof(_topics[entry.handle]));
 				}
 			}
 		};
-		append(_topicReplacements, a_parentId);
-		append(_topicReplacementOrphans, a_topicId);
+		if (mayHaveStatic) {
+			Stats::Add(Stats::filterPassed);
+			append(_topicReplacements, a_parentId);
+			append(_topicReplacementOrphans, a_topicId);
+		}
 		return ret;
 	}
 
-	std::string DialogueManager::AddReplacementTopic(RE::FormID a_topicId, std::string a_text)
+	std::vector<int32_t> DialogueManager::AddReplacementTopics(std::span<const RE::FormID> a_topicIds, std::span<const std::string> a_texts)
 	{
+		if (a_topicIds.size() != a_texts.size()) {
+			logger::warn("AddReplacementTopics: got {} topics but {} texts, nothing added", a_topicIds.size(), a_texts.size());
+			return {};
+		}
+		// build the records before taking the lock, so it is held only for the insertion. Lookups skip temporary topics while it is held
+		std::vector<std::shared_ptr<const Topic>> topics{};
+		topics.reserve(a_topicIds.size());
+		for (size_t i = 0; i < a_topicIds.size(); i++) {
+			topics.push_back(std::make_shared<const Topic>(a_topicIds[i], a_texts[i]));
+		}
+		std::vector<int32_t> handles{};
+		handles.reserve(a_topicIds.size());
 		std::unique_lock lock{ _tempTopicMutex };
-		std::string key{ Random::generateUUID() };
-		if (_tempTopicKeys.count(a_topicId)) {
-			logger::info("overwrite detected on {} - previous key = {}", a_topicId, _tempTopicKeys.count(a_topicId));
+		for (size_t i = 0; i < a_topicIds.size(); i++) {
+			// handles are positive, the counter wraps around freely
+			int32_t handle;
+			do {
+				handle = static_cast<int32_t>(_nextTempHandle++ & 0x7FFF'FFFF);
+			} while (handle == 0);
+			auto& entry = _tempTopicReplacements[a_topicIds[i]];
+			if (entry.topic) {
+				logger::info("overwrite detected on {:X} - previous handle = {}", a_topicIds[i], entry.handle);
+			}
+			entry = { handle, std::move(topics[i]) };
+			handles.push_back(handle);
 		}
-		_tempTopicKeys[a_topicId] = key;
-		_tempTopicReplacements[a_topicId] = std::make_shared<Topic>(a_topicId, a_text);
-		return key;
+		_tempTopicCount = _tempTopicReplacements.size();
+		return handles;
 	}
 
-	void DialogueManager::RemoveReplacementTopic(RE::FormID a_topicId, std::string a_key)
+	void DialogueManager::RemoveReplacementTopics(std::span<const RE::FormID> a_topicIds, std::span<const int32_t> a_handles)
 	{
+		if (a_topicIds.size() != a_handles.size()) {
+			logger::warn("RemoveReplacementTopics: got {} topics but {} handles, nothing removed", a_topicIds.size(), a_handles.size());
+			return;
+		}
 		std::unique_lock lock{ _tempTopicMutex };
+		for (size_t i = 0; i < a_topicIds.size(); i++) {
+			if (const auto where = _tempTopicReplacements.find(a_topicIds[i]); where != _tempTopicReplacements.end() && where->second.handle == a_handles[i]) {
+				_tempTopicReplacements.erase(where);
+			}
+		}
+		_tempTopicCount = _tempTopicReplacements.size();
+	}
+
+	std::string DialogueManager::AddReplacementTopic(RE::FormID a_topicId, const std::string& a_text)
+	{
+		const auto handles = AddReplacementTopics({ std::addressof(a_topicId), 1 }, { std::addressof(a_text), 1 });
+		return std::to_string(handles.front());
+	}
 
-		if (_tempTopicKeys.count(a_topicId) && _tempTopicKeys[a_topicId] != a_key) {
+	void DialogueManager::RemoveReplacementTopic(RE::FormID a_topicId, std::string_view a_key)
+	{
+		int32_t handle = 0;
+		const auto [end, ec] = std::from_chars(a_key.data(), a_key.data() + a_key.size(), handle);
+		if (ec != std::errc{} || end != a_key.data() + a_key.size()) {
 			return;
 		}
-
-		_tempTopicKeys.erase(a_topicId);
-		_tempTopicReplacements.erase(a_topicId);
+		RemoveReplacementTopics({ std::addressof(a_topicId), 1 }, { std::addressof(handle), 1 });
 	}
 	
 	void DialogueManager::ApplyTextReplacements(std::string& a_text, RE::TESObjectREFR* a_speaker, ReplacementType a_type)
 	{
-		if (a_text.empty()) {
+		if (a_text.empty() || !_ready) {
 			return;
 		}
 		const auto actor = a_speaker ? a_speaker->As<RE::Actor>() : nullptr;
 		const auto target = actor ? GetDialogueTarget(actor) : nullptr;
-		const uint32_t speakerId = actor ? actor->GetFormID() : 0;
-		const uint32_t targetId = target ? target->GetFormID() : 0;
-		_lua.ForEachScript([&](const TextReplacement& a_replacement, sol::environment& a_env) {
-			if (a_replacement.CanApplyReplacement(a_speaker, target, a_type)) {
-				try {
-					std::unique_lock lock{ _luaMutex };
-					a_env["context"] = std::to_underlying(a_type);
-					a_env["speaker_id"] = speakerId;
-					a_env["target_id"] = targetId;
-					sol::protected_function_result result = a_env["replace"](a_text);
-					if (!result.valid()) {
-						sol::error err = result;
-						logger::error("Failed to apply replacement - {}", err.what());
-					} else if (result.get_type() != sol::type::string) {
-						const auto type = magic_enum::enum_name(result.get_type());
-						logger::error("Failed to apply replacement - expected string, got {}", type);
-					} else {
-						a_text = result;
-					}
-				} catch (const std::exception& e) {
-					logger::error("Failed to apply replacement - {}", e.what());
-				}
-			}
-		});
+		ApplyTextReplacements(a_text, actor ? actor->GetFormID() : 0, target ? target->GetFormID() : 0, a_type);
 	}
 
-	LuaData::LuaData()
+	void DialogueManager::ApplyTextReplacements(std::string& a_text, const DialogueSession& a_session, ReplacementType a_type)
 	{
-		lua.open_libraries(sol::lib::base, sol::lib::package, sol::lib::string, sol::lib::table, sol::lib::math);
+		if (a_text.empty() || !_ready) {
+			return;
+		}
+		ApplyTextReplacements(a_text, a_session.GetSpeakerId(), a_session.GetTargetId(), a_type);
+	}
 
-		lua.set_function("get_formid", [](uint32_t a_id, const std::string& a_esp) -> uint32_t {
-			return RE::TESDataHandler::GetSingleton()->LookupFormID(a_id, a_esp);
-		});
-		lua.set_function("has_keyword", [](uint32_t a_id, const std::string& a_kwd, bool a_partialMatch) -> int {
-			auto form = RE::TESForm::LookupByID<RE::BGSKeywordForm>(a_id);
-			if (!form) {
-				return -1;
-			}
-			return a_partialMatch ? form->ContainsKeywordString(a_kwd) : form->HasKeywordString(a_kwd);
-		});
-		lua.set_function("is_in_faction", [](uint32_t a_id, uint32_t a_faction) -> int {
-			auto form = RE::TESForm::LookupByID<RE::Actor>(a_id);
-			auto fac = RE::TESForm::LookupByID<RE::TESFaction>(a_faction);
-			if (!form || !fac) {
-				return -1;
-			}
-			return form->IsInFaction(fac);
-		});
-		lua.set_function("has_magic_effect", [](uint32_t a_id, uint32_t a_magicEffect) -> int {
-			auto form = RE::TESForm::LookupByID<RE::Actor>(a_id);
-			auto mgEff = RE::TESForm::LookupByID<RE::EffectSetting>(a_magicEffect);
-			if (!form) {
-				return -1;
-			}
-			return form->AsMagicTarget()->HasMagicEffect(mgEff);
-		});
-		lua.set_function("get_relationship_rank", [](uint32_t a_id, uint32_t a_target) -> std::string {
-			auto form = RE::TESForm::LookupByID<RE::Actor>(a_id);
-			auto target = RE::TESForm::LookupByID<RE::Actor>(a_target);
-			if (!form || !target) {
-				return "";
-			}
-			auto formBase = form->GetActorBase();
-			auto targetBase = target->GetActorBase();
-			if (!formBase || !targetBase || !formBase->relationships) {
-				return "";
-			}
-			for (auto&& it : *formBase->relationships) {
-				if (it->npc1 == targetBase || it->npc2 == targetBase) {
-					auto lv = it->level.get();
-					std::string ret{ magic_enum::enum_name(lv) };
-					return ret;
-				}
-			}
-			return "";
-		});
-		lua.set_function("get_sex", [](uint32_t a_id) -> int {
-			auto form = RE::TESForm::LookupByID(a_id);
-			if (!form) {
-				return -1;
-			} else if (auto act = form->As<RE::Actor>()) {
-				auto base = act->GetActorBase();
-				return base ? base->GetSex() : -1;
-			} else if (auto npc = form->As<RE::TESNPC>()) {
-				return npc->GetSex();
+	void DialogueManager::ApplyTextReplacements(std::string& a_text, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type)
+	{
+		// scripts are fixed once loaded, matching their triggers needs no lock
+		auto triggers = _lua.ScanTriggers(a_text, a_type);
+		std::unique_lock lock{ _luaMutex };
+		if (_luaWorkers.IsRunning() && !HasNativeReplacer(a_speaker, a_target, a_type) && !_lua.RequiresMainThread(triggers, a_speaker, a_target, a_type)) {
+			lock.unlock();
+			auto result = _luaWorkers.Submit(a_text, a_speaker, a_target, a_type);
+			if (result.wait_for(std::chrono::duration<float, std::milli>(Settings::workerWait)) != std::future_status::ready) {
+				Stats::Add(Stats::workerTimeouts);
+				logger::warn("Lua worker missed its deadline, original text kept");
+				return;
 			}
-			return -1;
-		});
-		lua.set_function("get_name", [](uint32_t a_id) -> std::string {
-			auto form = RE::TESForm::LookupByID(a_id);
-			if (!form) {
-				return "NONE";
+			a_text = std::move(result.get().front());
+			return;
+		}
+		_lua.ResetMemo();
+		RunReplacers(a_text, std::move(triggers), a_speaker, a_target, a_type);
+		if (_lua.NeedsCollection()) {
+			ScheduleCollection();
+		}
+	}
+
+	LuaWorkerPool::Result DialogueManager::ApplyTextReplacementsAsync(std::vector<std::string> a_texts, const DialogueSession& a_session, ReplacementType a_type, std::function<void()> a_onDone)
+	{
+		if (!a_texts.empty() && _ready) {
+			const auto speakerId = a_session.GetSpeakerId();
+			const auto targetId = a_session.GetTargetId();
+			auto triggers = _lua.ScanTriggers(a_texts, a_type);
+			std::unique_lock lock{ _luaMutex };
+			if (_luaWorkers.IsRunning() && !HasNativeReplacer(speakerId, targetId, a_type) && !_lua.RequiresMainThread(triggers, speakerId, targetId, a_type)) {
+				lock.unlock();
+				return _luaWorkers.Submit(std::move(a_texts), speakerId, targetId, a_type, std::move(a_onDone));
 			}
-			std::string ret{ form->GetName() };
-			if (ret.empty()) {
-				if (auto act = form->As<RE::Actor>()) {
-					const auto base = act->GetActorBase();
-					return base ? base->GetName() : ret;
-				}
+			_lua.ResetMemo();
+			RunReplacers(a_texts, std::move(triggers), speakerId, targetId, a_type);
+			if (_lua.NeedsCollection()) {
+				ScheduleCollection();
 			}
-			return ret;
-		});
-		lua.set_function("send_mod_event", [](const std::string& event, const std::string& argStr, float argNum, uint32_t argForm) {
-			SKSE::ModCallbackEvent modEvent{
-				event,
-				argStr,
-				argNum,
-				argForm ? RE::TESForm::LookupByID(argForm) : nullptr
-			};
-			SKSE::GetModCallbackEventSource()->SendEvent(&modEvent);
-		});
+		}
+		std::promise<std::vector<std::string>> ret{};
+		ret.set_value(std::move(a_texts));
+		return ret.get_future();
 	}
 
-	bool LuaData::InitializeEnvironment(TextReplacement a_replacement)
+	bool DialogueManager::RegisterNativeReplacer(const DDR_TextReplacerInfo& a_info)
 	{
-		sol::environment env{ lua, sol::create, lua.globals() };
-		if (!env.valid()) {
-			logger::error("Failed to create environment");
+		try {
+			NativeReplacer replacer{ a_info };
+			std::unique_lock lock{ _luaMutex };
+			const auto where = std::ranges::upper_bound(_nativeReplacers, replacer.GetPriority(), std::ranges::greater{}, &NativeReplacer::GetPriority);
+			const auto& added = *_nativeReplacers.insert(where, std::move(replacer));
+			logger::info("Registered native replacer {} with priority {}", added.GetName(), added.GetPriority());
+			return true;
+		} catch (const std::exception& e) {
+			logger::error("Failed to register native replacer {} - {}", a_info.name ? a_info.name : "<unnamed>", e.what());
 			return false;
 		}
-		const auto scriptName = a_replacement.GetScript();
-		const auto scriptPatch = std::format("{}/{}", SCRIPT_PATH, scriptName);
-		if (!fs::exists(scriptPatch)) {
-			logger::error("Failed to load script. Invalid path - {}", scriptPatch);
-			return false;
-		}
-		lua.script_file(scriptPatch, env);
-		if (!env.valid()) {
-			logger::error("Failed to load script - {}", scriptPatch);
-			return false;
-		} else if (!env["replace"].valid()) {
-			logger::error("Failed to find replace function");
-			return false;
-		}
-		std::string scriptNameStr{ scriptName };
-		env.set_function("log_info", [=](const std::string& message) {
-			logger::info("Lua - {} - {}", scriptNameStr, message);
-		});
-		env.set_function("log_error", [=](const std::string& message) {
-			logger::error("Lua - {} - {}", scriptNameStr, message);
-		});
-		if (!env.valid()) {
-			logger::error("Failed to set functions");
-			return false;
+	}
+
+	bool DialogueManager::HasNativeReplacer(RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type) const
+	{
+		return std::ranges::any_of(_nativeReplacers, [&](const NativeReplacer& a_replacer) { return a_replacer.CanApplyReplacement(a_speaker, a_target, a_type); });
+	}
+
+	template <class T>
+	void DialogueManager::RunReplacers(T& a_texts, LuaData::Triggers a_triggers, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type)
+	{
+		LuaData::Window window{};
+		for (const auto& replacer : _nativeReplacers) {
+			if (!replacer.CanApplyReplacement(a_speaker, a_target, a_type)) {
+				continue;
+			}
+			// scripts of equal priority run first
+			window.lowest = replacer.GetPriority();
+			_lua.Apply(a_texts, a_triggers, a_speaker, a_target, a_type, window);
+			window.highest = window.lowest;
+			replacer.Apply(a_texts, a_speaker, a_target, a_type);
+			// the replacer may have changed which scripts the remaining windows trigger
+			a_triggers = _lua.ScanTriggers(a_texts, a_type);
 		}
-		scripts.emplace_back(a_replacement, env);
-		return true;
+		window.lowest = std::numeric_limits<int64_t>::min();
+		_lua.Apply(a_texts, a_triggers, a_speaker, a_target, a_type, window);
 	}
-	
-	void LuaData::ForEachScript(std::function<void(const TextReplacement&, sol::environment&)> a_func)
+
+	void DialogueManager::CollectGarbage()
+	{
+		std::unique_lock lock{ _luaMutex };
+		_lua.CollectGarbage(Settings::gcStepTime);
+	}
+
+	void DialogueManager::ScheduleCollection()
 	{
-		for (auto& [repl, env] : scripts) {
-			a_func(repl, env);
+		if (_collectionScheduled.exchange(true)) {
+			return;
 		}
+		SKSE::GetTaskInterface()->AddTask([this]() {
+			_collectionScheduled = false;
+			// while in dialogue only capped steps run, a full collection is left for the menu to run when it closes
+			if (const auto ui = RE::UI::GetSingleton(); ui && ui->IsMenuOpen(RE::DialogueMenu::MENU_NAME)) {
+				std::unique_lock lock{ _luaMutex };
+				_lua.CollectGarbage(Settings::gcStepTime, false);
+				return;
+			}
+			CollectGarbage();
+		});
 	}
 
 } // namespace DDR
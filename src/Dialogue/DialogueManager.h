@@ -1,33 +1,61 @@
 #pragma once
 
-#define SOL_ALL_SAFETIES_ON 1
-#include <lua.hpp>
-#include <sol/sol.hpp>
-
 #include "Conditions/RefMap.h"
+#include "LoadProfiler.h"
+#include "LuaData.h"
+#include "LuaWorkerPool.h"
+#include "NativeReplacer.h"
+#include "ReplacementFile.h"
+#include "ReplacementStore.h"
 #include "TextReplacement.h"
 #include "Topic.h"
 #include "TopicInfo.h"
+#include "Util/FormFilter.h"
 #include "Util/Singleton.h"
 
 namespace DDR
 {
 	constexpr static std::string_view DIRECTORY_PATH = "Data\\SKSE\\DynamicDialogueReplacer";
-	constexpr static std::string_view SCRIPT_PATH = "Data\\SKSE\\DynamicDialogueReplacer\\Scripts";
 
-	struct LuaData
+	/// @brief Topic replacements matching a lookup, sorted by priority
+	struct TopicReplacements
 	{
-		LuaData();
-		~LuaData() { lua.collect_garbage(); }
+		std::shared_ptr<const Topic> temporary{ nullptr };	// keeps a runtime replacement alive while the result is in use
+		std::vector<const Topic*> topics{};
 
-		bool InitializeEnvironment(TextReplacement a_replacement);
-		void ForEachScript(std::function<void(const TextReplacement&, sol::environment&)> a_func);
+		_NODISCARD bool empty() const { return topics.empty(); }
+		_NODISCARD auto begin() const { return topics.begin(); }
+		_NODISCARD auto end() const { return topics.end(); }
+	};
 
-	private:
-		sol::state lua{};
-		std::vector<std::pair<TextReplacement, sol::environment>> scripts{};
+	/// @brief The replacement candidates of a topic the player may pick next, looked up ahead of time
+	/// Nothing is decided here: conditions and random choices are only evaluated once the topic is picked
+	struct PreparedResponse
+	{
+		struct Candidate
+		{
+			const TopicInfo* response;
+			std::vector<std::string> voicePaths{};	// expanded voice file by response number - 1, empty where the original file is kept
+		};
+
+		RE::TESTopicInfo* topicInfo;
+		RE::Character* speaker;
+		RE::BGSVoiceType* voiceType;
+		uint32_t epoch;
+		bool filtered{ false };						// rejected by the replacement filter
+		std::span<const Entry> entries{};		// candidates in index order
+		std::vector<Candidate> candidates{};	// parallel to entries
+
+		/// @return the expanded voice files of a_response, nullptr if it is not a candidate
+		_NODISCARD std::vector<std::string>* FindVoicePaths(const TopicInfo* a_response)
+		{
+			const auto where = std::ranges::find(candidates, a_response, &Candidate::response);
+			return where != candidates.end() ? std::addressof(where->voicePaths) : nullptr;
+		}
 	};
 
+	class DialogueSession;
+
 	class DialogueManager : 
 		public Singleton<DialogueManager>
 	{
@@ -35,28 +63,121 @@ namespace DDR
 		static RE::TESObjectREFR* GetDialogueTarget(RE::Actor* a_speaker);
 
 	public:
+		/// @brief Start reading replacement files and compiling scripts on a worker thread. Nothing read here depends on game data
+		void StartPreload();
+		/// @brief Resolve and index the preloaded replacements. Called once game data is loaded, until then every lookup finds nothing
 		void Init();
-		std::shared_ptr<TopicInfo> FindReplacementResponse(RE::Character* a_speaker, RE::TESTopicInfo* a_topicInfo, RE::TESTopicInfo::ResponseData* a_responseData);
-		std::vector<std::shared_ptr<Topic>> FindReplacementTopic(RE::FormID a_parentId, RE::FormID a_topicId, RE::TESObjectREFR* a_target, bool a_preprocessing);
+		const TopicInfo* FindReplacementResponse(RE::Character* a_speaker, RE::TESTopicInfo* a_topicInfo, RE::TESTopicInfo::ResponseData* a_responseData);
+		/// @brief Same as above, with speaker, target and voice type taken from a_session
+		const TopicInfo* FindReplacementResponse(const DialogueSession& a_session, RE::TESTopicInfo* a_topicInfo);
+		/// @brief Same as above, picking among the prepared candidates. Conditions, random choices and statistics behave as for an unprepared lookup
+		const TopicInfo* FindReplacementResponse(const DialogueSession& a_session, const PreparedResponse& a_prepared);
+		/// @brief Same as above without side effects: no statistics, and the first random entry whose conditions hold instead of a draw
+		_NODISCARD const TopicInfo* PeekReplacementResponse(RE::Character* a_speaker, RE::TESTopicInfo* a_topicInfo) const;
+		/// @brief Look up the replacement candidates of a_topicInfos in advance. Runs as an idle task while the dialogue menu is open
+		void PrepareResponses(RE::Character* a_speaker, std::span<RE::TESTopicInfo* const> a_topicInfos);
+		/// @brief Take the prepared replacement of a_topicInfo, if one was resolved for this speaker since the last invalidation
+		std::optional<PreparedResponse> TakePreparedResponse(RE::Character* a_speaker, RE::TESTopicInfo* a_topicInfo);
+		/// @brief Discard all prepared replacements. Called whenever the state they were resolved against may have changed
+		void InvalidatePreparedResponses();
+		TopicReplacements FindReplacementTopic(RE::FormID a_parentId, RE::FormID a_topicId, RE::TESObjectREFR* a_target, bool a_preprocessing);
 
-		std::string AddReplacementTopic(RE::FormID a_topicId, std::string a_text);
-		void RemoveReplacementTopic(RE::FormID a_topicId, std::string a_key);
+		/// @brief Add a temporary text for each topic, replacing any earlier temporary text of the same topic. All texts become visible at once
+		/// @return a handle per topic, to remove its text with. Empty if the lists differ in length
+		std::vector<int32_t> AddReplacementTopics(std::span<const RE::FormID> a_topicIds, std::span<const std::string> a_texts);
+		/// @brief Remove the temporary texts of the given topics at once. A text is only removed if its handle matches
+		void RemoveReplacementTopics(std::span<const RE::FormID> a_topicIds, std::span<const int32_t> a_handles);
+		/// @brief Single topic form of AddReplacementTopics, the handle is returned as a key string
+		std::string AddReplacementTopic(RE::FormID a_topicId, const std::string& a_text);
+		void RemoveReplacementTopic(RE::FormID a_topicId, std::string_view a_key);
+		/// @brief Apply text replacements to a single line. Waits at most Settings::workerWait if the line is handed to a worker
 		void ApplyTextReplacements(std::string& a_text, RE::TESObjectREFR* a_speaker, ReplacementType a_type);
+		void ApplyTextReplacements(std::string& a_text, const DialogueSession& a_session, ReplacementType a_type);
+		/// @brief Apply text replacements to a list of lines. Runs on a worker if all applicable scripts are pure, otherwise the result is ready on return
+		/// @param a_onDone called from the worker when the result becomes available, not called if the result is ready on return
+		LuaWorkerPool::Result ApplyTextReplacementsAsync(std::vector<std::string> a_texts, const DialogueSession& a_session, ReplacementType a_type, std::function<void()> a_onDone = {});
+		/// @brief Add a text replacer of another plugin. Native replacers run on the calling thread, in priority order with the scripts
+		/// @return false if a_info is invalid
+		bool RegisterNativeReplacer(const DDR_TextReplacerInfo& a_info);
+		/// @brief Run a bounded amount of Lua garbage collection. Called when the dialogue menu closes and from idle frames
+		void CollectGarbage();
 
 	private:
-		size_t ParseResponses(const YAML::Node& a_node, const Conditions::RefMap& a_refMap);
-		size_t ParseTopics(const YAML::Node& a_node, const Conditions::RefMap& a_refMap);
-		size_t ParseScripts(const YAML::Node& a_node);
+		struct SourceFile
+		{
+			std::string name;
+			Handle responses;	 // first response record parsed from this file
+			Handle topics;		 // first topic record parsed from this file
+		};
+
+		/// @brief Replacement files and script bytecode, as read before game data is available
+		struct Preload
+		{
+			struct File
+			{
+				std::string name;
+				std::optional<ReplacementFile> contents;	// empty if the file failed to load
+			};
+
+			std::vector<File> files{};
+			std::unordered_map<std::string, std::string> bytecode{};	// by script name
+			LoadProfiler profiler{};
+			std::chrono::steady_clock::time_point begin{};
+			std::chrono::steady_clock::time_point end{};
+		};
+
+		static Preload LoadFiles();
+		size_t ParseResponses(ReplacementFile& a_file, const Conditions::RefMap& a_refMap);
+		size_t ParseTopics(ReplacementFile& a_file, const Conditions::RefMap& a_refMap);
+		size_t ParseScripts(ReplacementFile& a_file, const std::unordered_map<std::string, std::string>& a_bytecode);
+		/// @brief Stage all valid records into the replacement indices. Every form id used as a lookup key is appended to a_keys
+		void BindReplacements(const std::vector<SourceFile>& a_files, std::vector<RE::FormID>& a_keys);
+		const TopicInfo* FindReplacementResponse(RE::Character* a_speaker, RE::TESObjectREFR* a_target, RE::BGSVoiceType* a_voiceType, RE::TESTopicInfo* a_topicInfo);
+		/// @brief Replacement entries of a_topicInfo for a_voiceType, falling back to those for every voice. No side effects
+		_NODISCARD std::span<const Entry> FindResponseEntries(RE::TESTopicInfo* a_topicInfo, RE::BGSVoiceType* a_voiceType) const;
+		/// @brief The highest priority entry whose conditions hold, drawing among random entries of that priority
+		const TopicInfo* PickResponse(std::span<const Entry> a_entries, RE::Character* a_speaker, RE::TESObjectREFR* a_target);
+		void ApplyTextReplacements(std::string& a_text, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type);
+		void ScheduleCollection();
+		/// @brief If a native replacer applies. Requires _luaMutex
+		_NODISCARD bool HasNativeReplacer(RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type) const;
+		/// @brief Run scripts and native replacers by priority. Scripts between two native replacers share a single call into the VM. Requires _luaMutex
+		/// a_triggers is the scan of a_texts, it is refreshed after every native replacer
+		template <class T>
+		void RunReplacers(T& a_texts, LuaData::Triggers a_triggers, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type);
+		/// @brief Compile the conditions of every record on a worker thread, so none are parsed during dialogue
+		void CompileInBackground();
 
 	private:
+		std::future<Preload> _preload{};
+		std::atomic<bool> _ready{ false };
 		LuaData _lua{};
 		std::mutex _luaMutex{};
-		std::map<std::string, std::vector<std::shared_ptr<TopicInfo>>> _responseReplacements;
-		std::unordered_map<RE::FormID, std::vector<std::shared_ptr<Topic>>> _topicReplacements;
-		std::unordered_map<RE::FormID, std::vector<std::shared_ptr<Topic>>> _topicReplacementOrphans;	// Replacements without a parent topic
+		std::atomic<bool> _collectionScheduled{ false };
+		LuaWorkerPool _luaWorkers{};
+		std::vector<NativeReplacer> _nativeReplacers{};	 // sorted by priority, guarded by _luaMutex
+		RecordStore<TopicInfo> _responses;
+		RecordStore<Topic> _topics;
+		ReplacementIndex<std::uint64_t> _responseReplacements;	// keyed by TopicInfo::GenerateHash
+		ReplacementIndex<RE::FormID> _topicReplacements;
+		ReplacementIndex<RE::FormID> _topicReplacementOrphans;	// Replacements without a parent topic
+		Util::FormFilter _replacementFilter;	 // every topic info and topic id with a static replacement
 
-		std::unordered_map<RE::FormID, std::string> _tempTopicKeys;
-		std::unordered_map<RE::FormID, std::shared_ptr<Topic>> _tempTopicReplacements;
+		struct TempTopic
+		{
+			int32_t handle;
+			std::shared_ptr<const Topic> topic;
+		};
+
+		std::unordered_map<RE::FormID, TempTopic> _tempTopicReplacements;
 		std::mutex _tempTopicMutex{};
+		uint32_t _nextTempHandle{ 1 };	 // randomly seeded in Init
+		std::atomic<size_t> _tempTopicCount{ 0 };
+
+		std::vector<PreparedResponse> _preparedResponses{};
+		std::mutex _preparedMutex{};
+		uint32_t _preparedEpoch{ 0 };
+
+		std::jthread _compiler{};
 	};
 }	 // namespace DDR
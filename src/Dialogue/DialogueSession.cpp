@@ -0,0 +1,122 @@
+#include "DialogueSession.h"
+
+#include "Stats.h"
+
+namespace DDR
+{
+	namespace
+	{
+		RE::BGSVoiceType* LookupVoiceType(RE::TESObjectREFR* a_speaker)
+		{
+			const auto actor = a_speaker ? a_speaker->As<RE::Actor>() : nullptr;
+			const auto base = actor ? actor->GetActorBase() : nullptr;
+			return base ? base->GetVoiceType() : nullptr;
+		}
+
+		RE::FormID LookupSpeakerId(RE::TESObjectREFR* a_speaker)
+		{
+			const auto actor = a_speaker ? a_speaker->As<RE::Actor>() : nullptr;
+			return actor ? actor->GetFormID() : 0;
+		}
+	}
+
+	DialogueSession::DialogueSession(RE::TESObjectREFR* a_speaker, RE::TESObjectREFR* a_target) :
+		_speaker(a_speaker),
+		_target(a_target),
+		_speakerId(LookupSpeakerId(a_speaker)),
+		_targetId(a_target ? a_target->GetFormID() : 0),
+		_voiceType(LookupVoiceType(a_speaker)),
+		_conversation(_conversations.load())
+	{
+		_placeholders.Bind(_speaker, _target);
+		Stats::Add(Stats::sessionsCreated);
+	}
+
+	void DialogueSession::BeginConversation()
+	{
+		_conversations++;
+		PlaceholderValues::BeginSession();
+	}
+
+	RE::TESObjectREFR* DialogueSession::ResolveTarget(RE::TESObjectREFR* a_speaker)
+	{
+		const auto actor = a_speaker ? a_speaker->As<RE::Actor>() : nullptr;
+		return actor ? DialogueManager::GetDialogueTarget(actor) : nullptr;
+	}
+
+	bool DialogueSession::Matches(RE::TESObjectREFR* a_speaker, RE::TESObjectREFR* a_target) const
+	{
+		if (_conversation != _conversations.load() || _speaker != a_speaker || _target != a_target) {
+			return false;
+		}
+		const auto speakerId = LookupSpeakerId(a_speaker);
+		const auto targetId = a_target ? a_target->GetFormID() : 0;
+		return speakerId == _speakerId && targetId == _targetId && LookupVoiceType(a_speaker) == _voiceType;
+	}
+
+	void DialogueSession::BeginResponse(RE::TESTopicInfo* a_topicInfo, const TopicInfo* a_replacement, std::optional<PreparedResponse> a_prepared, clock::time_point a_picked)
+	{
+		_picked = a_picked;
+		_responseNumber = 1;
+		// placeholders are resolved again once the dialogue menu opened or closed since the last line
+		if (_placeholders.Bind(_speaker, _target)) {
+			std::ranges::fill(_subtitles, std::nullopt);
+		}
+		if (_topicInfo == a_topicInfo && _replacement == a_replacement) {
+			Stats::Add(Stats::sessionResponsesReused);
+			return;
+		}
+		_topicInfo = a_topicInfo;
+		_replacement = a_replacement;
+		_subtitles.clear();
+		_voicePaths.clear();
+		if (!_replacement) {
+			return;
+		}
+		const auto count = static_cast<size_t>(_replacement->GetResponseCount());
+		_subtitles.resize(count);
+		_voicePaths.resize(count);
+		if (const auto prepared = a_prepared && a_prepared->voiceType == _voiceType ? a_prepared->FindVoicePaths(_replacement) : nullptr) {
+			for (size_t i = 0; i < count && i < prepared->size(); i++) {
+				if (!(*prepared)[i].empty()) {
+					_voicePaths[i] = std::move((*prepared)[i]);
+				}
+			}
+		}
+	}
+
+	const std::string* DialogueSession::GetSubtitle()
+	{
+		if (!_replacement || !_replacement->HasReplacementSubtitle(_responseNumber)) {
+			return nullptr;
+		}
+		auto& subtitle = _subtitles[_responseNumber - 1];
+		if (subtitle) {
+			Stats::Add(Stats::sessionCacheHits);
+		} else {
+			subtitle = _replacement->GetSubtitle(_responseNumber).Expand(_placeholders);
+			Stats::Add(Stats::sessionCacheMisses);
+		}
+		return std::addressof(*subtitle);
+	}
+
+	const std::string* DialogueSession::GetVoiceFilePath(RE::TESTopic* a_topic, RE::TESTopicInfo* a_topicInfo, RE::BGSVoiceType* a_voiceType, int32_t a_num)
+	{
+		if (!_replacement || !_replacement->HasReplacementVoiceFile(a_num)) {
+			return nullptr;
+		}
+		if (a_voiceType != _voiceType) {
+			// a voice other than the speaker's, too rare to be cached
+			_otherVoicePath = _replacement->GetVoiceFilePath(a_topic, a_topicInfo, a_voiceType, a_num);
+			return std::addressof(_otherVoicePath);
+		}
+		auto& path = _voicePaths[a_num - 1];
+		if (path) {
+			Stats::Add(Stats::sessionCacheHits);
+		} else {
+			path = _replacement->GetVoiceFilePath(a_topic, a_topicInfo, a_voiceType, a_num);
+			Stats::Add(Stats::sessionCacheMisses);
+		}
+		return std::addressof(*path);
+	}
+}	 // namespace DDR
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "DialogueManager.h"
+#include "Placeholders.h"
+
+namespace DDR
+{
+	/// @brief A conversation with one speaker and target. Holds everything the hooks need for the lines spoken in it
+	/// Created when a response starts or the dialogue menu shows, and kept for as long as speaker and target stay the same
+	class DialogueSession
+	{
+		using clock = std::chrono::steady_clock;
+
+	public:
+		DialogueSession(RE::TESObjectREFR* a_speaker, RE::TESObjectREFR* a_target);
+
+		/// @brief Start a new conversation, sessions created before no longer match. Called whenever the dialogue menu opens or closes
+		static void BeginConversation();
+		/// @brief Dialogue target of a_speaker, nullptr if it is not an actor. Resolved for every line, the session keeps it while it matches
+		_NODISCARD static RE::TESObjectREFR* ResolveTarget(RE::TESObjectREFR* a_speaker);
+
+		/// @brief If this session still belongs to a_speaker and a_target. Ids and voice type are compared too, references may be unloaded and their address reused
+		_NODISCARD bool Matches(RE::TESObjectREFR* a_speaker, RE::TESObjectREFR* a_target) const;
+
+		_NODISCARD RE::TESObjectREFR* GetSpeaker() const { return _speaker; }
+		_NODISCARD RE::TESObjectREFR* GetTarget() const { return _target; }
+		/// @brief Form id of the speaker if it is an actor, 0 otherwise. Passed to scripts and native replacers
+		_NODISCARD RE::FormID GetSpeakerId() const { return _speakerId; }
+		_NODISCARD RE::FormID GetTargetId() const { return _targetId; }
+		_NODISCARD RE::BGSVoiceType* GetVoiceType() const { return _voiceType; }
+		_NODISCARD PlaceholderValues& GetPlaceholders() { return _placeholders; }
+
+		/// @brief Start speaking a_topicInfo. Expanded texts are kept if the same replacement is spoken again
+		/// @param a_prepared voice files expanded while the player browsed, if any
+		void BeginResponse(RE::TESTopicInfo* a_topicInfo, const TopicInfo* a_replacement, std::optional<PreparedResponse> a_prepared, clock::time_point a_picked);
+		void SetResponseNumber(int32_t a_num) { _responseNumber = a_num; }
+
+		_NODISCARD const TopicInfo* GetReplacement() const { return _replacement; }
+		_NODISCARD int32_t GetResponseNumber() const { return _responseNumber; }
+		_NODISCARD clock::time_point GetPickTime() const { return _picked; }
+		_NODISCARD bool ShouldCut() const { return _replacement && _replacement->ShouldCut(_responseNumber); }
+		/// @brief Replacement subtitle of the current line with placeholders expanded, nullptr if the line keeps its subtitle
+		_NODISCARD const std::string* GetSubtitle();
+		/// @brief Replacement voice file of line a_num, nullptr if the line keeps its file
+		_NODISCARD const std::string* GetVoiceFilePath(RE::TESTopic* a_topic, RE::TESTopicInfo* a_topicInfo, RE::BGSVoiceType* a_voiceType, int32_t a_num);
+
+	private:
+		RE::TESObjectREFR* _speaker;
+		RE::TESObjectREFR* _target;
+		RE::FormID _speakerId;
+		RE::FormID _targetId;
+		RE::BGSVoiceType* _voiceType{ nullptr };
+		PlaceholderValues _placeholders{};
+		uint32_t _conversation;
+
+		RE::TESTopicInfo* _topicInfo{ nullptr };
+		const TopicInfo* _replacement{ nullptr };
+		int32_t _responseNumber{ -1 };
+		clock::time_point _picked{};
+		std::vector<std::optional<std::string>> _subtitles{};		// by line, expanded on first use
+		std::vector<std::optional<std::string>> _voicePaths{};	 // by line, for the speaker's voice type
+		std::string _otherVoicePath{};
+
+		static inline std::atomic<uint32_t> _conversations{ 0 };
+	};
+}	 // namespace DDR
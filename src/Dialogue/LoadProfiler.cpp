@@ -0,0 +1,142 @@
+#include "LoadProfiler.h"
+
+#include "Settings.h"
+#include "Util/StringUtil.h"
+
+namespace DDR
+{
+	namespace
+	{
+		double ToMilliseconds(std::chrono::steady_clock::duration a_duration)
+		{
+			return std::chrono::duration<double, std::milli>(a_duration).count();
+		}
+
+		std::string EscapeJson(std::string_view a_str)
+		{
+			std::string ret{};
+			ret.reserve(a_str.size());
+			for (const char c : a_str) {
+				switch (c) {
+				case '"':
+					ret += "\\\"";
+					break;
+				case '\\':
+					ret += "\\\\";
+					break;
+				default:
+					if (static_cast<unsigned char>(c) < 0x20) {
+						ret += std::format("\\u{:04x}", static_cast<unsigned int>(c));
+					} else {
+						ret += c;
+					}
+					break;
+				}
+			}
+			return ret;
+		}
+
+		template <class E, class D, size_t N>
+		std::string TimingsToJson(const std::array<D, N>& a_timings)
+		{
+			std::string ret{ "{" };
+			for (size_t i = 0; i < N; i++) {
+				const auto name = Util::CastLower(std::string{ magic_enum::enum_name(magic_enum::enum_value<E>(i)) });
+				ret += std::format("{}\"{}\": {:.3f}", i ? ", " : "", name, ToMilliseconds(a_timings[i]));
+			}
+			return ret + "}";
+		}
+	}
+
+	LoadProfiler::File& LoadProfiler::BeginFile(std::string a_name)
+	{
+		_files.emplace_back(std::move(a_name));
+		return ResumeFile(_files.size() - 1);
+	}
+
+	LoadProfiler::File& LoadProfiler::ResumeFile(size_t a_index)
+	{
+		_current = a_index;
+		_fileBegin = clock::now();
+		return _files[a_index];
+	}
+
+	void LoadProfiler::EndFile()
+	{
+		auto& file = _files[_current];
+		file.total += clock::now() - _fileBegin;
+	}
+
+	void LoadProfiler::Report(size_t a_count) const
+	{
+		logger::info("Loaded {} files in {:.1f}ms, {:.1f}ms overlapped with game startup, {:.1f}ms waiting for it",
+			_files.size(), ToMilliseconds(GetBusyTime()), ToMilliseconds(_overlap), ToMilliseconds(_stages[magic_enum::enum_integer(Stage::Wait)]));
+		std::vector<const File*> slowest{};
+		slowest.reserve(_files.size());
+		for (const auto& file : _files) {
+			slowest.push_back(std::addressof(file));
+		}
+		const auto count = std::min(a_count, slowest.size());
+		std::ranges::partial_sort(slowest, slowest.begin() + count, std::ranges::greater{}, &File::total);
+		for (size_t i = 0; i < count; i++) {
+			const auto& file = *slowest[i];
+			const auto& phases = file.phases;
+			logger::info("\t{:.1f}ms {} (read {:.1f}ms, compile {:.1f}ms, refMap {:.1f}ms, responses {:.1f}ms, topics {:.1f}ms, scripts {:.1f}ms, {} KB, {} conditions)",
+				ToMilliseconds(file.total), file.name,
+				ToMilliseconds(phases[magic_enum::enum_integer(Phase::Read)]),
+				ToMilliseconds(phases[magic_enum::enum_integer(Phase::Compile)]),
+				ToMilliseconds(phases[magic_enum::enum_integer(Phase::RefMap)]),
+				ToMilliseconds(phases[magic_enum::enum_integer(Phase::Responses)]),
+				ToMilliseconds(phases[magic_enum::enum_integer(Phase::Topics)]),
+				ToMilliseconds(phases[magic_enum::enum_integer(Phase::Scripts)]),
+				file.bytes / 1024, file.conditions);
+		}
+
+		auto path = logger::log_directory();
+		if (!path) {
+			logger::warn("Failed to locate the log directory, load report not written");
+			return;
+		}
+		*path /= std::format("{}_Load.json", SKSE::PluginDeclaration::GetSingleton()->GetName());
+		std::ofstream out{ *path, std::ios::trunc };
+		if (!out) {
+			logger::warn("Failed to write load report to {}", path->string());
+			return;
+		}
+		out << ToJson();
+		logger::info("Wrote load report to {}", path->string());
+	}
+
+	LoadProfiler::clock::duration LoadProfiler::GetBusyTime() const
+	{
+		clock::duration ret{};
+		for (const auto& file : _files) {
+			ret += file.total;
+		}
+		for (size_t i = 0; i < _stages.size(); i++) {
+			if (i != static_cast<size_t>(magic_enum::enum_integer(Stage::Wait))) {
+				ret += _stages[i];
+			}
+		}
+		return ret;
+	}
+
+	std::string LoadProfiler::ToJson() const
+	{
+		std::string ret{ "{\n" };
+		ret += "\t\"timeUnit\": \"ms\",\n";
+		ret += std::format("\t\"streaming\": {},\n", Settings::streamingLoader);
+		ret += std::format("\t\"total\": {:.3f},\n", ToMilliseconds(GetBusyTime()));
+		ret += std::format("\t\"overlap\": {:.3f},\n", ToMilliseconds(_overlap));
+		ret += std::format("\t\"stages\": {},\n", TimingsToJson<Stage>(_stages));
+		ret += "\t\"files\": [";
+		for (size_t i = 0; i < _files.size(); i++) {
+			const auto& file = _files[i];
+			ret += i ? ",\n\t\t{" : "\n\t\t{";
+			ret += std::format("\"name\": \"{}\", \"failed\": {}, \"total\": {:.3f}, \"phases\": {}, ", EscapeJson(file.name), file.failed, ToMilliseconds(file.total), TimingsToJson<Phase>(file.phases));
+			ret += std::format("\"responses\": {}, \"topics\": {}, \"scripts\": {}, \"conditions\": {}, \"bytes\": {}}}", file.responses, file.topics, file.scripts, file.conditions, file.bytes);
+		}
+		ret += _files.empty() ? "]\n}\n" : "\n\t]\n}\n";
+		return ret;
+	}
+}	 // namespace DDR
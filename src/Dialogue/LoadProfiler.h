@@ -0,0 +1,103 @@
+#pragma once
+
+namespace DDR
+{
+	/// @brief Records where time and memory go while replacement files are loaded
+	/// A file may be profiled in several sessions, e.g. read on the preload thread and resolved once game data is available. Results are logged as a summary of the slowest files and written as a JSON report next to the plugin log
+	class LoadProfiler
+	{
+		using clock = std::chrono::steady_clock;
+
+	public:
+		/// @brief Per file phases
+		enum class Phase
+		{
+			Read,				// file I/O and YAML parse, interleaved when streaming
+			Compile,		// Lua bytecode of the referenced scripts
+			RefMap,
+			Responses,
+			Topics,
+			Scripts,		// running scripts and setting up their environment
+		};
+
+		/// @brief Phases run once over all files
+		enum class Stage
+		{
+			Wait,				// blocked on the preload thread
+			Bind,
+			Filter,
+			Pipelines,
+			Sort,
+		};
+
+		using Timings = std::array<clock::duration, magic_enum::enum_count<Phase>()>;
+
+		struct File
+		{
+			std::string name;
+			Timings phases{};
+			clock::duration total{};		 // over all sessions
+			size_t responses{ 0 };
+			size_t topics{ 0 };
+			size_t scripts{ 0 };
+			size_t conditions{ 0 };
+			size_t bytes{ 0 };		 // size of the file on disk
+			bool failed{ false };
+
+			/// @brief Invoke a_func, adding its runtime to a_phase. Returns the result of a_func
+			template <class F>
+			decltype(auto) Measure(Phase a_phase, F&& a_func)
+			{
+				const Timer timer{ phases[magic_enum::enum_integer(a_phase)] };
+				return std::forward<F>(a_func)();
+			}
+		};
+
+	public:
+		/// @brief Start profiling a new file. The returned reference is valid until the next call
+		File& BeginFile(std::string a_name);
+		/// @brief Start another session on the a_index'th file passed to BeginFile
+		File& ResumeFile(size_t a_index);
+		void EndFile();
+		void Add(Stage a_stage, clock::duration a_time) { _stages[magic_enum::enum_integer(a_stage)] += a_time; }
+		/// @brief Time the preload thread ran before game data was available
+		void SetOverlap(clock::duration a_overlap) { _overlap = a_overlap; }
+
+		template <class F>
+		decltype(auto) Measure(Stage a_stage, F&& a_func)
+		{
+			const Timer timer{ _stages[magic_enum::enum_integer(a_stage)] };
+			return std::forward<F>(a_func)();
+		}
+
+		/// @brief Log the a_count slowest files and write the full report to the log directory
+		void Report(size_t a_count) const;
+
+	private:
+		class Timer
+		{
+		public:
+			explicit Timer(clock::duration& a_target) :
+				_target(a_target), _start(clock::now()) {}
+			~Timer() { _target += clock::now() - _start; }
+
+			Timer(const Timer&) = delete;
+			Timer& operator=(const Timer&) = delete;
+
+		private:
+			clock::duration& _target;
+			clock::time_point _start;
+		};
+
+		/// @brief Time spent working on the load, on any thread
+		clock::duration GetBusyTime() const;
+		std::string ToJson() const;
+
+	private:
+		std::vector<File> _files{};
+		std::array<clock::duration, magic_enum::enum_count<Stage>()> _stages{};
+		clock::duration _overlap{};
+		size_t _current{ 0 };
+		clock::time_point _fileBegin{};
+	};
+}	 // namespace DDR
@@ -0,0 +1,684 @@
+#include "LuaData.h"
+
+#include "Settings.h"
+#include "Stats.h"
+
+namespace DDR
+{
+	namespace
+	{
+		constexpr int BUDGET_HOOK_INTERVAL = 1000;
+
+		// Threads a line through every enabled stage inside the VM. Each stage is isolated by its own pcall,
+		// failures are reported back as (stage, message) pairs so C++ only sees one call and one result per line.
+		constexpr std::string_view PIPELINE_DRIVER = R"(
+			local stages, mask, enter = ...
+			local pcall, type, tostring = pcall, type, tostring
+
+			local function fail(failures, i, ok, res)
+				failures = failures or {}
+				failures[#failures + 1] = i
+				failures[#failures + 1] = ok and ("expected string, got " .. type(res)) or tostring(res)
+				return failures
+			end
+
+			local function replace(text, context, speaker_id, target_id)
+				local failures
+				for i = 1, #stages do
+					if mask[i] then
+						local env = stages[i]
+						env.context, env.speaker_id, env.target_id = context, speaker_id, target_id
+						enter(i, 1)
+						local ok, res = pcall(env.replace, text)
+						if ok and type(res) == "string" then
+							text = res
+						else
+							failures = fail(failures, i, ok, res)
+						end
+					end
+				end
+				enter(0)
+				return text, failures
+			end
+
+			-- lines[i] lists the lines which triggered stage i, nil if all of them did
+			local function replace_batch(texts, lines, context_table, context, speaker_id, target_id)
+				local failures
+				local n = #texts
+				for i = 1, #stages do
+					if mask[i] then
+						local env = stages[i]
+						env.context, env.speaker_id, env.target_id = context, speaker_id, target_id
+						local only = lines[i]
+						local m = only and #only or n
+						enter(i, m)
+						local batch = env.replace_batch
+						if type(batch) == "function" then
+							local input = {}
+							for j = 1, m do input[j] = texts[only and only[j] or j] end
+							local ok, res = pcall(batch, input, context_table)
+							if ok and type(res) == "table" then
+								for j = 1, m do
+									local v = res[j]
+									if type(v) == "string" then texts[only and only[j] or j] = v else failures = fail(failures, i, true, v) end
+								end
+							else
+								failures = fail(failures, i, ok, res)
+							end
+						else
+							for j = 1, m do
+								local k = only and only[j] or j
+								local ok, res = pcall(env.replace, texts[k])
+								if ok and type(res) == "string" then texts[k] = res else failures = fail(failures, i, ok, res) end
+							end
+						end
+					end
+				end
+				enter(0)
+				return failures
+			end
+
+			return replace, replace_batch
+		)";
+
+		constexpr std::string_view PIPELINE_CHUNK_PREFIX = "ddr_pipeline_";
+
+		constexpr size_t PipelineIndex(ReplacementType a_type)
+		{
+			switch (a_type) {
+			case ReplacementType::Topic:
+				return 0;
+			case ReplacementType::Response:
+				return 1;
+			default:
+				assert(false && "replacements with type Any have no pipeline of their own");
+				return 0;
+			}
+		}
+	}
+
+	void LuaData::Budget::Reset(const TextReplacement& a_replacement, int64_t a_calls)
+	{
+		const auto maxInstructions = a_replacement.GetInstructionBudget();
+		const auto time = a_replacement.GetTimeBudget() * static_cast<float>(a_calls);
+		instructions = maxInstructions > 0 ? static_cast<int64_t>(maxInstructions) * a_calls : std::numeric_limits<int64_t>::max();
+		deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float, std::milli>(time));
+		limitTime = time > 0.0f;
+		active = maxInstructions > 0 || limitTime;
+		exceeded = false;
+	}
+
+	void LuaData::BudgetHook(lua_State* L, lua_Debug* a_debug)
+	{
+		const auto budget = _activeBudget;
+		if (!budget || !budget->active) {
+			return;
+		}
+		if (budget->exceeded) {
+			// Keep failing until the stage ends, a script catching the error with its own pcall must not run on
+			// The driver is spared, it only ends the stage after the script's pcall returned
+			lua_getinfo(L, "S", a_debug);
+			if (!std::string_view{ a_debug->source }.starts_with(PIPELINE_CHUNK_PREFIX)) {
+				luaL_error(L, "script exceeded its execution budget");
+			}
+			return;
+		}
+		budget->instructions -= BUDGET_HOOK_INTERVAL;
+		if (budget->instructions <= 0 || (budget->limitTime && std::chrono::steady_clock::now() > budget->deadline)) {
+			budget->exceeded = true;
+			luaL_error(L, "script exceeded its execution budget");
+		}
+	}
+
+	int LuaData::EnterStage(lua_State* L)
+	{
+		auto& pipeline = *static_cast<Pipeline*>(lua_touserdata(L, lua_upvalueindex(1)));
+		auto& budget = pipeline.budget;
+		if (pipeline.current > 0 && budget.exceeded) {
+			pipeline.overran[pipeline.current - 1] = true;
+		}
+		const auto stage = static_cast<size_t>(luaL_checkinteger(L, 1));
+		const auto calls = static_cast<int64_t>(luaL_optinteger(L, 2, 1));
+		pipeline.current = stage;
+		if (stage == 0 || stage > pipeline.stages.size()) {
+			budget.active = false;
+			budget.exceeded = false;
+			pipeline.current = 0;
+		} else {
+			budget.Reset(pipeline.stages[stage - 1]->replacement, std::max<int64_t>(calls, 1));
+		}
+		return 0;
+	}
+
+	LuaData::LuaData(bool a_sandboxed) :
+		sandboxed(a_sandboxed)
+	{
+		lua.open_libraries(sol::lib::base, sol::lib::package, sol::lib::string, sol::lib::table, sol::lib::math);
+
+		emptyString = sol::make_object(lua, ""sv);
+		noneString = sol::make_object(lua, "NONE"sv);
+		using RelationshipLevel = decltype(std::declval<RE::BGSRelationship>().level.get());
+		for (const auto& name : magic_enum::enum_names<RelationshipLevel>()) {
+			rankNames.push_back(sol::make_object(lua, name));
+		}
+
+		if (!sandboxed) {
+			RegisterFormHelpers();
+		}
+		// the collector is driven explicitly so it never steps in the middle of a replacement
+		lua_gc(lua.lua_state(), LUA_GCSTOP, 0);
+	}
+
+	void LuaData::RegisterFormHelpers()
+	{
+		lua.set_function("get_formid", [](uint32_t a_id, const std::string& a_esp) -> uint32_t {
+			return RE::TESDataHandler::GetSingleton()->LookupFormID(a_id, a_esp);
+		});
+		lua.set_function("has_keyword", [this](uint32_t a_id, std::string_view a_kwd, bool a_partialMatch) -> int {
+			return HasKeyword(a_id, a_kwd, a_partialMatch);
+		});
+		lua.set_function("is_in_faction", [this](uint32_t a_id, uint32_t a_faction) -> int {
+			return IsInFaction(a_id, a_faction);
+		});
+		lua.set_function("has_magic_effect", [this](uint32_t a_id, uint32_t a_magicEffect) -> int {
+			return HasMagicEffect(a_id, a_magicEffect);
+		});
+		lua.set_function("get_relationship_rank", [this](uint32_t a_id, uint32_t a_target) -> sol::object {
+			return GetRelationshipRank(a_id, a_target);
+		});
+		lua.set_function("get_sex", [this](uint32_t a_id) -> int {
+			return GetSex(a_id);
+		});
+		lua.set_function("get_name", [this](uint32_t a_id) -> sol::object {
+			return GetName(a_id);
+		});
+		lua.set_function("send_mod_event", [this](const std::string& event, const std::string& argStr, float argNum, uint32_t argForm) {
+			SKSE::ModCallbackEvent modEvent{
+				event,
+				argStr,
+				argNum,
+				argForm ? LookupForm(argForm) : nullptr
+			};
+			SKSE::GetModCallbackEventSource()->SendEvent(&modEvent);
+		});
+
+#ifdef DDR_LUA_FFI
+		InitializeFFI();
+#endif
+	}
+
+	void LuaData::CollectGarbage(float a_budget, bool a_allowFull)
+	{
+		const auto L = lua.lua_state();
+		const auto start = std::chrono::steady_clock::now();
+		// worker states are reported apart, their pauses never block a hook
+		if (a_allowFull && GetHeapSize() > static_cast<size_t>(Settings::gcFullThreshold) * 1024) {
+			lua_gc(L, LUA_GCCOLLECT, 0);
+			Stats::Add(sandboxed ? Stats::workerGcFullCollections : Stats::gcFullCollections);
+		} else {
+			const auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float, std::milli>(a_budget));
+			while (lua_gc(L, LUA_GCSTEP, 0) == 0 && std::chrono::steady_clock::now() < deadline) {}
+			Stats::Add(sandboxed ? Stats::workerGcSteps : Stats::gcSteps);
+		}
+		// explicit collections reset the threshold, which would resume automatic stepping
+		lua_gc(L, LUA_GCSTOP, 0);
+		const auto pause = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+		Stats::Add(sandboxed ? Stats::workerGcPauseTotal : Stats::gcPauseTotal, pause);
+		Stats::Max(sandboxed ? Stats::workerGcPauseMax : Stats::gcPauseMax, pause);
+		lastCollectionHeap = GetHeapSize();
+		if (!sandboxed) {
+			Stats::luaHeapSize.store(lastCollectionHeap, std::memory_order_relaxed);
+		}
+	}
+
+	bool LuaData::NeedsCollection() const
+	{
+		return GetHeapSize() > lastCollectionHeap + static_cast<size_t>(Settings::gcIdleThreshold) * 1024;
+	}
+
+	size_t LuaData::GetHeapSize() const
+	{
+		const auto L = lua.lua_state();
+		return static_cast<size_t>(lua_gc(L, LUA_GCCOUNT, 0)) * 1024 + static_cast<size_t>(lua_gc(L, LUA_GCCOUNTB, 0));
+	}
+
+	void LuaData::ResetMemo()
+	{
+		memo.forms.clear();
+		memo.names.clear();
+		memo.relationshipRanks.clear();
+		memo.sexes.clear();
+	}
+
+	RE::TESForm* LuaData::LookupForm(uint32_t a_id)
+	{
+		const auto [where, inserted] = memo.forms.try_emplace(a_id, nullptr);
+		if (inserted) {
+			where->second = RE::TESForm::LookupByID(a_id);
+		}
+		return where->second;
+	}
+
+	int LuaData::HasKeyword(uint32_t a_id, std::string_view a_keyword, bool a_partialMatch)
+	{
+		auto form = LookupForm<RE::BGSKeywordForm>(a_id);
+		if (!form) {
+			return -1;
+		}
+		return a_partialMatch ? form->ContainsKeywordString(a_keyword) : form->HasKeywordString(a_keyword);
+	}
+
+	int LuaData::IsInFaction(uint32_t a_id, uint32_t a_faction)
+	{
+		auto form = LookupForm<RE::Actor>(a_id);
+		auto fac = LookupForm<RE::TESFaction>(a_faction);
+		if (!form || !fac) {
+			return -1;
+		}
+		return form->IsInFaction(fac);
+	}
+
+	int LuaData::HasMagicEffect(uint32_t a_id, uint32_t a_magicEffect)
+	{
+		auto form = LookupForm<RE::Actor>(a_id);
+		auto mgEff = LookupForm<RE::EffectSetting>(a_magicEffect);
+		if (!form) {
+			return -1;
+		}
+		return form->AsMagicTarget()->HasMagicEffect(mgEff);
+	}
+
+	int LuaData::GetSex(uint32_t a_id)
+	{
+		const auto [where, inserted] = memo.sexes.try_emplace(a_id, -1);
+		if (!inserted) {
+			return where->second;
+		}
+		auto form = LookupForm(a_id);
+		if (!form) {
+			return -1;
+		} else if (auto act = form->As<RE::Actor>()) {
+			auto base = act->GetActorBase();
+			where->second = base ? base->GetSex() : -1;
+		} else if (auto npc = form->As<RE::TESNPC>()) {
+			where->second = npc->GetSex();
+		}
+		return where->second;
+	}
+
+	sol::object LuaData::GetRelationshipRank(uint32_t a_id, uint32_t a_target)
+	{
+		const auto key = (static_cast<uint64_t>(a_id) << 32) | a_target;
+		const auto [where, inserted] = memo.relationshipRanks.try_emplace(key, emptyString);
+		if (!inserted) {
+			return where->second;
+		}
+		auto form = LookupForm<RE::Actor>(a_id);
+		auto target = LookupForm<RE::Actor>(a_target);
+		if (!form || !target) {
+			return where->second;
+		}
+		auto formBase = form->GetActorBase();
+		auto targetBase = target->GetActorBase();
+		if (!formBase || !targetBase || !formBase->relationships) {
+			return where->second;
+		}
+		for (auto&& it : *formBase->relationships) {
+			if (it->npc1 == targetBase || it->npc2 == targetBase) {
+				if (const auto idx = magic_enum::enum_index(it->level.get())) {
+					where->second = rankNames[*idx];
+				}
+				break;
+			}
+		}
+		return where->second;
+	}
+
+	sol::object LuaData::GetName(uint32_t a_id)
+	{
+		const auto [where, inserted] = memo.names.try_emplace(a_id, noneString);
+		if (!inserted) {
+			return where->second;
+		}
+		auto form = LookupForm(a_id);
+		if (!form) {
+			return where->second;
+		}
+		std::string_view name{ form->GetName() };
+		if (name.empty()) {
+			if (auto act = form->As<RE::Actor>()) {
+				const auto base = act->GetActorBase();
+				name = base ? base->GetName() : name;
+			}
+		}
+		where->second = name.empty() ? emptyString : sol::make_object(lua, name);
+		return where->second;
+	}
+
+	std::string LuaData::CompileScript(const std::string& a_path)
+	{
+		const std::unique_ptr<lua_State, decltype(&lua_close)> state{ luaL_newstate(), &lua_close };
+		const auto L = state.get();
+		if (!L) {
+			throw std::runtime_error("Failed to create Lua state");
+		}
+		if (luaL_loadfile(L, a_path.c_str()) != 0) {
+			throw std::runtime_error(lua_tostring(L, -1));
+		}
+		std::string ret{};
+		const auto writer = [](lua_State*, const void* a_data, size_t a_size, void* a_out) -> int {
+			static_cast<std::string*>(a_out)->append(static_cast<const char*>(a_data), a_size);
+			return 0;
+		};
+		if (lua_dump(L, writer, std::addressof(ret)) != 0) {
+			throw std::runtime_error("Failed to dump bytecode");
+		}
+		return ret;
+	}
+
+	bool LuaData::InitializeEnvironment(TextReplacement a_replacement, std::string_view a_bytecode)
+	{
+		sol::environment env{ lua, sol::create, lua.globals() };
+		if (!env.valid()) {
+			logger::error("Failed to create environment");
+			return false;
+		}
+		const auto scriptName = a_replacement.GetScript();
+		const auto scriptPatch = std::format("{}/{}", SCRIPT_PATH, scriptName);
+		if (a_bytecode.empty() && !fs::exists(scriptPatch)) {
+			logger::error("Failed to load script. Invalid path - {}", scriptPatch);
+			return false;
+		}
+		sol::load_result chunk = a_bytecode.empty() ? lua.load_file(scriptPatch) : lua.load(a_bytecode, "@" + scriptPatch, sol::load_mode::binary);
+		if (!chunk.valid()) {
+			sol::error err = chunk;
+			logger::error("Failed to load script {} - {}", scriptPatch, err.what());
+			return false;
+		}
+		sol::protected_function main = chunk;
+		if (a_replacement.GetInstructionBudget() > 0 || a_replacement.GetTimeBudget() > 0.0f) {
+			// count hooks never fire inside compiled traces, budgeted scripts have to stay in the interpreter
+			const auto L = lua.lua_state();
+			main.push();
+			luaJIT_setmode(L, -1, LUAJIT_MODE_ALLFUNC | LUAJIT_MODE_OFF);
+			lua_pop(L, 1);
+		}
+		sol::set_environment(env, main);
+		if (auto result = main(); !result.valid()) {
+			sol::error err = result;
+			logger::error("Failed to run script {} - {}", scriptPatch, err.what());
+			return false;
+		}
+		if (!env.valid()) {
+			logger::error("Failed to load script - {}", scriptPatch);
+			return false;
+		} else if (!env["replace"].valid()) {
+			logger::error("Failed to find replace function");
+			return false;
+		}
+		std::string scriptNameStr{ scriptName };
+		env.set_function("log_info", [=](const std::string& message) {
+			logger::info("Lua - {} - {}", scriptNameStr, message);
+		});
+		env.set_function("log_error", [=](const std::string& message) {
+			logger::error("Lua - {} - {}", scriptNameStr, message);
+		});
+		if (!env.valid()) {
+			logger::error("Failed to set functions");
+			return false;
+		}
+		scripts.emplace_back(a_replacement, env);
+		return true;
+	}
+
+	void LuaData::BuildPipelines()
+	{
+		// stable, so scripts of equal priority keep their load order. Workers load the same scripts and end up with the same order
+		std::ranges::stable_sort(scripts, std::ranges::greater{}, [](const Script& a_script) { return a_script.replacement.GetPriority(); });
+		for (const auto type : { ReplacementType::Topic, ReplacementType::Response }) {
+			auto& pipeline = pipelines[PipelineIndex(type)];
+			pipeline = Pipeline{};
+			auto stages = lua.create_table();
+			for (auto& script : scripts) {
+				const auto scriptType = script.replacement.GetType();
+				if (scriptType != ReplacementType::Any && scriptType != type)
+					continue;
+				pipeline.stages.push_back(std::addressof(script));
+				stages.add(script.env);
+				pipeline.budgeted |= script.replacement.GetInstructionBudget() > 0 || script.replacement.GetTimeBudget() > 0.0f;
+			}
+			if (pipeline.stages.empty())
+				continue;
+			pipeline.mask.assign(pipeline.stages.size(), false);
+			pipeline.overran.assign(pipeline.stages.size(), false);
+			pipeline.luaMask = lua.create_table(static_cast<int>(pipeline.stages.size()), 0);
+			const auto L = lua.lua_state();
+			lua_pushlightuserdata(L, std::addressof(pipeline));
+			lua_pushcclosure(L, &EnterStage, 1);
+			sol::protected_function enter{ L, -1 };
+			lua_pop(L, 1);
+			sol::protected_function builder = lua.load(PIPELINE_DRIVER, std::format("{}{}", PIPELINE_CHUNK_PREFIX, magic_enum::enum_name(type)));
+			sol::protected_function_result result = builder(stages, pipeline.luaMask, enter);
+			if (!result.valid()) {
+				sol::error err = result;
+				logger::critical("Failed to build {} script pipeline - {}", magic_enum::enum_name(type), err.what());
+				pipeline = Pipeline{};
+				continue;
+			}
+			pipeline.driver = result.get<sol::protected_function>(0);
+			pipeline.batchDriver = result.get<sol::protected_function>(1);
+			logger::info("Built {} {}script pipeline with {} stages", magic_enum::enum_name(type), sandboxed ? "worker " : "", pipeline.stages.size());
+		}
+		// drop everything left over from loading the scripts, the collector stays stopped afterwards
+		lua_gc(lua.lua_state(), LUA_GCCOLLECT, 0);
+		lua_gc(lua.lua_state(), LUA_GCSTOP, 0);
+		lastCollectionHeap = GetHeapSize();
+		if (!sandboxed) {
+			Stats::luaHeapSize.store(lastCollectionHeap, std::memory_order_relaxed);
+			logger::info("Lua heap after loading: {} KB", lastCollectionHeap / 1024);
+		}
+	}
+
+	bool LuaData::UpdateMask(Pipeline& a_pipeline, const Triggers& a_triggers, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type, Window a_window)
+	{
+		bool any = false;
+		for (size_t i = 0; i < a_pipeline.stages.size(); i++) {
+			const auto& script = *a_pipeline.stages[i];
+			// in a batch, a script is enabled as soon as one line triggers it. BuildLines narrows it down to those lines
+			const bool enabled = a_triggers[i] && a_window.Contains(script.replacement.GetPriority()) && IsEnabled(script, a_speaker, a_target, a_type);
+			if (enabled != static_cast<bool>(a_pipeline.mask[i])) {
+				a_pipeline.mask[i] = enabled;
+				a_pipeline.luaMask[i + 1] = enabled;
+			}
+			any |= enabled;
+		}
+		return any;
+	}
+
+	sol::table LuaData::BuildLines(const Pipeline& a_pipeline, std::span<const std::string> a_texts)
+	{
+		auto ret = lua.create_table();
+		std::vector<std::uint8_t> triggered(a_texts.size());
+		for (size_t i = 0; i < a_pipeline.stages.size(); i++) {
+			if (!a_pipeline.mask[i]) {
+				continue;
+			}
+			const auto& replacement = a_pipeline.stages[i]->replacement;
+			size_t count = 0;
+			for (size_t j = 0; j < a_texts.size(); j++) {
+				triggered[j] = replacement.IsTriggeredBy(a_texts[j]);
+				count += triggered[j];
+			}
+			if (count == a_texts.size()) {
+				continue;
+			}
+			auto lines = lua.create_table(static_cast<int>(count), 0);
+			for (size_t j = 0, k = 1; j < a_texts.size(); j++) {
+				if (triggered[j]) {
+					lines[k++] = j + 1;
+				}
+			}
+			ret[i + 1] = lines;
+		}
+		return ret;
+	}
+
+	bool LuaData::IsEnabled(const Script& a_script, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type)
+	{
+		return !a_script.quarantined && a_script.replacement.CanApplyReplacement(a_speaker, a_target, a_type);
+	}
+
+	LuaData::Triggers LuaData::ScanTriggers(std::span<const std::string> a_texts, ReplacementType a_type) const
+	{
+		const auto& stages = pipelines[PipelineIndex(a_type)].stages;
+		Triggers ret(stages.size());
+		for (size_t i = 0; i < stages.size(); i++) {
+			ret[i] = std::ranges::any_of(a_texts, [&](const auto& text) { return stages[i]->replacement.IsTriggeredBy(text); });
+		}
+		return ret;
+	}
+
+	bool LuaData::RequiresMainThread(const Triggers& a_triggers, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type) const
+	{
+		const auto& stages = pipelines[PipelineIndex(a_type)].stages;
+		for (size_t i = 0; i < stages.size(); i++) {
+			if (a_triggers[i] && !stages[i]->replacement.IsPure() && IsEnabled(*stages[i], a_speaker, a_target, a_type)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void LuaData::BeginPipeline(Pipeline& a_pipeline)
+	{
+		std::ranges::fill(a_pipeline.overran, false);
+		a_pipeline.current = 0;
+		a_pipeline.budget.active = false;
+		if (a_pipeline.budgeted) {
+			_activeBudget = std::addressof(a_pipeline.budget);
+			lua_sethook(lua.lua_state(), BudgetHook, LUA_MASKCOUNT, BUDGET_HOOK_INTERVAL);
+		}
+	}
+
+	void LuaData::EndPipeline(Pipeline& a_pipeline, const sol::object& a_failures)
+	{
+		if (a_pipeline.budgeted) {
+			lua_sethook(lua.lua_state(), nullptr, 0, 0);
+			_activeBudget = nullptr;
+		}
+		if (a_pipeline.current > 0 && a_pipeline.budget.exceeded) {
+			a_pipeline.overran[a_pipeline.current - 1] = true;
+		}
+		if (a_failures.get_type() == sol::type::table) {
+			const auto failures = a_failures.as<sol::table>();
+			for (size_t i = 1; i + 1 <= failures.size(); i += 2) {
+				const auto stage = failures.get<size_t>(i);
+				const auto message = failures.get<std::string>(i + 1);
+				const auto script = stage > 0 && stage <= a_pipeline.stages.size() ? a_pipeline.stages[stage - 1]->replacement.GetScript() : "<unknown>"sv;
+				logger::error("Failed to apply replacement {} - {}", script, message);
+			}
+		}
+		for (size_t i = 0; i < a_pipeline.overran.size(); i++) {
+			if (a_pipeline.overran[i]) {
+				OnBudgetExceeded(*a_pipeline.stages[i]);
+			}
+		}
+	}
+
+	void LuaData::Apply(std::string& a_text, const Triggers& a_triggers, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type, Window a_window)
+	{
+		auto& pipeline = pipelines[PipelineIndex(a_type)];
+		if (!pipeline.driver.valid() || !UpdateMask(pipeline, a_triggers, a_speaker, a_target, a_type, a_window)) {
+			return;
+		}
+		BeginPipeline(pipeline);
+		sol::protected_function_result result = pipeline.driver(a_text, std::to_underlying(a_type), a_speaker, a_target);
+		if (!result.valid()) {
+			EndPipeline(pipeline, sol::lua_nil);
+			sol::error err = result;
+			logger::error("Failed to run {} script pipeline - {}", magic_enum::enum_name(a_type), err.what());
+			return;
+		}
+		a_text = result.get<std::string>(0);
+		EndPipeline(pipeline, result.get<sol::object>(1));
+	}
+
+	void LuaData::Apply(std::vector<std::string>& a_texts, const Triggers& a_triggers, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type, Window a_window)
+	{
+		auto& pipeline = pipelines[PipelineIndex(a_type)];
+		if (!pipeline.batchDriver.valid() || !UpdateMask(pipeline, a_triggers, a_speaker, a_target, a_type, a_window)) {
+			return;
+		}
+		auto texts = lua.create_table(static_cast<int>(a_texts.size()), 0);
+		for (size_t i = 0; i < a_texts.size(); i++) {
+			texts[i + 1] = a_texts[i];
+		}
+		const auto lines = BuildLines(pipeline, a_texts);
+		auto context = lua.create_table_with("type", std::to_underlying(a_type), "speaker_id", a_speaker, "target_id", a_target);
+		BeginPipeline(pipeline);
+		sol::protected_function_result result = pipeline.batchDriver(texts, lines, context, std::to_underlying(a_type), a_speaker, a_target);
+		if (!result.valid()) {
+			EndPipeline(pipeline, sol::lua_nil);
+			sol::error err = result;
+			logger::error("Failed to run {} batch script pipeline - {}", magic_enum::enum_name(a_type), err.what());
+			return;
+		}
+		EndPipeline(pipeline, result.get<sol::object>(0));
+		for (size_t i = 0; i < a_texts.size(); i++) {
+			a_texts[i] = texts.get<std::string>(i + 1);
+		}
+	}
+
+	void LuaData::OnBudgetExceeded(Script& a_script)
+	{
+		a_script.overruns++;
+		const auto threshold = Settings::scriptQuarantineThreshold;
+		logger::warn("Script {} exceeded its budget ({} instructions, {}ms), original text kept. Overrun {}/{}",
+			a_script.replacement.GetScript(), a_script.replacement.GetInstructionBudget(), a_script.replacement.GetTimeBudget(), a_script.overruns, threshold);
+		if (threshold > 0 && a_script.overruns >= threshold) {
+			a_script.quarantined = true;
+			logger::error("Script {} quarantined after {} budget overruns", a_script.replacement.GetScript(), a_script.overruns);
+		}
+	}
+
+#ifdef DDR_LUA_FFI
+	// Numeric helpers bypass sol2 entirely. The prelude casts the raw function pointers with the FFI and
+	// rebinds the global helpers to thin wrappers, the JIT can then compile the calls directly into traces.
+	constexpr std::string_view FFI_PRELUDE = R"(
+		local ctx, has_keyword_fn, is_in_faction_fn, has_magic_effect_fn, get_sex_fn = ...
+		local ffi = require("ffi")
+		local has_keyword_c = ffi.cast("int (*)(void*, uint32_t, const char*, bool)", has_keyword_fn)
+		local is_in_faction_c = ffi.cast("int (*)(void*, uint32_t, uint32_t)", is_in_faction_fn)
+		local has_magic_effect_c = ffi.cast("int (*)(void*, uint32_t, uint32_t)", has_magic_effect_fn)
+		local get_sex_c = ffi.cast("int (*)(void*, uint32_t)", get_sex_fn)
+		has_keyword = function(id, kwd, partial) return has_keyword_c(ctx, id, kwd, partial and true or false) end
+		is_in_faction = function(id, faction) return is_in_faction_c(ctx, id, faction) end
+		has_magic_effect = function(id, effect) return has_magic_effect_c(ctx, id, effect) end
+		get_sex = function(id) return get_sex_c(ctx, id) end
+	)";
+
+	void LuaData::InitializeFFI()
+	{
+		lua.open_libraries(sol::lib::ffi);
+		sol::protected_function prelude = lua.load(FFI_PRELUDE, "ddr_ffi");
+		const auto result = prelude(
+			sol::lightuserdata_value{ this },
+			sol::lightuserdata_value{ reinterpret_cast<void*>(&FFIHasKeyword) },
+			sol::lightuserdata_value{ reinterpret_cast<void*>(&FFIIsInFaction) },
+			sol::lightuserdata_value{ reinterpret_cast<void*>(&FFIHasMagicEffect) },
+			sol::lightuserdata_value{ reinterpret_cast<void*>(&FFIGetSex) });
+		if (!result.valid()) {
+			sol::error err = result;
+			logger::error("Failed to initialize FFI helpers, falling back to regular bindings - {}", err.what());
+		}
+		// scripts must not get raw memory access
+		lua["ffi"] = sol::lua_nil;
+		lua["package"]["loaded"]["ffi"] = sol::lua_nil;
+	}
+
+	int LuaData::FFIHasKeyword(LuaData* a_this, uint32_t a_id, const char* a_keyword, bool a_partialMatch) { return a_this->HasKeyword(a_id, a_keyword ? a_keyword : "", a_partialMatch); }
+	int LuaData::FFIIsInFaction(LuaData* a_this, uint32_t a_id, uint32_t a_faction) { return a_this->IsInFaction(a_id, a_faction); }
+	int LuaData::FFIHasMagicEffect(LuaData* a_this, uint32_t a_id, uint32_t a_magicEffect) { return a_this->HasMagicEffect(a_id, a_magicEffect); }
+	int LuaData::FFIGetSex(LuaData* a_this, uint32_t a_id) { return a_this->GetSex(a_id); }
+#endif
+}	 // namespace DDR
@@ -0,0 +1,148 @@
+#pragma once
+
+#define SOL_ALL_SAFETIES_ON 1
+#include <lua.hpp>
+#include <sol/sol.hpp>
+
+#include "TextReplacement.h"
+
+namespace DDR
+{
+	constexpr static std::string_view SCRIPT_PATH = "Data\\SKSE\\DynamicDialogueReplacer\\Scripts";
+
+	struct LuaData
+	{
+		/// @brief Stages to run, by priority. Lets native replacers run in between scripts
+		struct Window
+		{
+			int64_t lowest{ std::numeric_limits<int64_t>::min() };		// inclusive
+			int64_t highest{ std::numeric_limits<int64_t>::max() };	 // exclusive
+
+			_NODISCARD bool Contains(int32_t a_priority) const { return a_priority >= lowest && a_priority < highest; }
+		};
+
+		struct Script
+		{
+			TextReplacement replacement;
+			sol::environment env;
+			uint32_t overruns{ 0 };
+			bool quarantined{ false };
+		};
+
+		/// @param a_sandboxed without any helper that touches game data, for states owned by worker threads
+		explicit LuaData(bool a_sandboxed = false);
+		~LuaData() { lua.collect_garbage(); }
+
+		/// @brief Compile a script file to bytecode without running it. Uses a private state and may be called from any thread
+		static std::string CompileScript(const std::string& a_path);
+
+		/// @brief Run a script and register its environment. a_bytecode is the output of CompileScript, if the script is loaded from source when empty
+		bool InitializeEnvironment(TextReplacement a_replacement, std::string_view a_bytecode = {});
+		/// @brief Compile the fused script pipelines, ordering scripts by priority. Must be called once after all scripts are initialized
+		void BuildPipelines();
+		/// @brief Per stage of the pipeline of a type, if any of the scanned texts triggers it
+		using Triggers = std::vector<std::uint8_t>;
+
+		/// @brief Match texts against the triggers of every script of a_type. Only reads what BuildPipelines fixed, so it needs no lock
+		_NODISCARD Triggers ScanTriggers(std::span<const std::string> a_texts, ReplacementType a_type) const;
+		_NODISCARD Triggers ScanTriggers(const std::string& a_text, ReplacementType a_type) const { return ScanTriggers({ std::addressof(a_text), 1 }, a_type); }
+		/// @brief Thread a line through every applicable script in a_window in a single call into the VM. a_triggers is the scan of a_text
+		void Apply(std::string& a_text, const Triggers& a_triggers, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type, Window a_window = {});
+		/// @brief Thread a list of lines through every applicable script in a_window, using replace_batch where scripts define it. a_triggers is the scan of a_texts
+		void Apply(std::vector<std::string>& a_texts, const Triggers& a_triggers, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type, Window a_window = {});
+		/// @brief If any script which is not marked pure would run on the scanned texts
+		_NODISCARD bool RequiresMainThread(const Triggers& a_triggers, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type) const;
+		/// @brief Run incremental collection for at most a_budget milliseconds, or a full collection if allowed and the heap grew past the configured threshold
+		void CollectGarbage(float a_budget, bool a_allowFull = true);
+		/// @brief If enough garbage accumulated since the last collection to warrant an idle step
+		_NODISCARD bool NeedsCollection() const;
+		/// @brief Lua heap size in bytes
+		_NODISCARD size_t GetHeapSize() const;
+		/// @brief Forget all memoized helper results. Called once at the start of every replacement pass
+		void ResetMemo();
+
+	private:
+		struct Budget
+		{
+			int64_t instructions{ 0 };
+			std::chrono::steady_clock::time_point deadline{};
+			bool limitTime{ false };
+			bool active{ false };
+			bool exceeded{ false };
+
+			void Reset(const TextReplacement& a_replacement, int64_t a_calls);
+		};
+
+		/// @brief All scripts of one replacement type, fused into a single Lua driver function
+		struct Pipeline
+		{
+			std::vector<Script*> stages{};
+			std::vector<std::uint8_t> mask{};		 // mirrors luaMask, avoids redundant table writes
+			std::vector<std::uint8_t> overran{};
+			sol::table luaMask{};
+			sol::protected_function driver{};
+			sol::protected_function batchDriver{};
+			Budget budget{};
+			size_t current{ 0 };	// 1-based index of the running stage, 0 if none
+			bool budgeted{ false };
+		};
+
+		/// @brief Helper results, valid for a single replacement pass. Strings are kept as Lua objects to push them without re-interning
+		struct Memo
+		{
+			std::unordered_map<uint32_t, RE::TESForm*> forms{};
+			std::unordered_map<uint32_t, sol::object> names{};
+			std::unordered_map<uint64_t, sol::object> relationshipRanks{};
+			std::unordered_map<uint32_t, int> sexes{};
+		};
+
+		static void BudgetHook(lua_State* L, lua_Debug* a_debug);
+		static int EnterStage(lua_State* L);
+
+		static bool IsEnabled(const Script& a_script, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type);
+
+		void RegisterFormHelpers();
+		bool UpdateMask(Pipeline& a_pipeline, const Triggers& a_triggers, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type, Window a_window);
+		/// @brief For every enabled stage which only some of a_texts trigger, the 1-based indices of those lines
+		sol::table BuildLines(const Pipeline& a_pipeline, std::span<const std::string> a_texts);
+		void BeginPipeline(Pipeline& a_pipeline);
+		void EndPipeline(Pipeline& a_pipeline, const sol::object& a_failures);
+		void OnBudgetExceeded(Script& a_script);
+
+		RE::TESForm* LookupForm(uint32_t a_id);
+		template <class T>
+		T* LookupForm(uint32_t a_id)
+		{
+			const auto form = LookupForm(a_id);
+			return form ? form->As<T>() : nullptr;
+		}
+
+		int HasKeyword(uint32_t a_id, std::string_view a_keyword, bool a_partialMatch);
+		int IsInFaction(uint32_t a_id, uint32_t a_faction);
+		int HasMagicEffect(uint32_t a_id, uint32_t a_magicEffect);
+		int GetSex(uint32_t a_id);
+		sol::object GetRelationshipRank(uint32_t a_id, uint32_t a_target);
+		sol::object GetName(uint32_t a_id);
+
+#ifdef DDR_LUA_FFI
+		void InitializeFFI();
+		static int FFIHasKeyword(LuaData* a_this, uint32_t a_id, const char* a_keyword, bool a_partialMatch);
+		static int FFIIsInFaction(LuaData* a_this, uint32_t a_id, uint32_t a_faction);
+		static int FFIHasMagicEffect(LuaData* a_this, uint32_t a_id, uint32_t a_magicEffect);
+		static int FFIGetSex(LuaData* a_this, uint32_t a_id);
+#endif
+
+	private:
+		sol::state lua{};
+		Memo memo{};
+		std::vector<sol::object> rankNames{};	 // indexed by magic_enum::enum_index of the relationship level
+		sol::object emptyString{};
+		sol::object noneString{};
+		std::vector<Script> scripts{};
+		std::array<Pipeline, 2> pipelines{};	// Topic, Response
+		size_t lastCollectionHeap{ 0 };
+		bool sandboxed{ false };
+
+		thread_local static inline Budget* _activeBudget{ nullptr };
+	};
+}	 // namespace DDR
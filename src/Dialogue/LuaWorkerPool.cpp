@@ -0,0 +1,128 @@
+#include "LuaWorkerPool.h"
+
+#include "Settings.h"
+#include "Stats.h"
+#include "Util/Random.h"
+
+namespace DDR
+{
+	void LuaWorkerPool::AddScript(TextReplacement a_replacement, std::string a_bytecode)
+	{
+		_scripts.emplace_back(std::move(a_replacement), std::move(a_bytecode));
+	}
+
+	void LuaWorkerPool::Start(size_t a_count)
+	{
+		if (IsRunning() || _scripts.empty() || a_count == 0) {
+			return;
+		}
+		// workers load their scripts before Start returns, so the first jobs do not time out waiting for them
+		std::latch ready{ static_cast<std::ptrdiff_t>(a_count) };
+		for (size_t i = 0; i < a_count; i++) {
+			_workers.emplace_back([this, i, &ready](std::stop_token a_stop) {
+				Random::bind(Random::Stream::kWorker, i);
+				Run(a_stop, ready);
+			});
+		}
+		ready.wait();
+		if (const auto failed = _failed.load(); failed > 0) {
+			// pure scripts then run on the main thread, as they do without workers
+			logger::error("{} of {} Lua workers failed to load their scripts, workers disabled", failed, a_count);
+			Stop();
+			return;
+		}
+		logger::info("Started {} Lua workers for {} pure scripts", a_count, _scripts.size());
+	}
+
+	void LuaWorkerPool::Stop()
+	{
+		for (auto& worker : _workers) {
+			worker.request_stop();
+		}
+		_workers.clear();
+		// jobs nobody ran complete with their texts unchanged, their completion callbacks have nothing to show
+		std::unique_lock lock{ _lock };
+		for (auto& job : _jobs) {
+			job.result.set_value(std::move(job.texts));
+		}
+		_jobs.clear();
+	}
+
+	LuaWorkerPool::Result LuaWorkerPool::Submit(std::string a_text, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type)
+	{
+		std::vector<std::string> texts{};
+		texts.push_back(std::move(a_text));
+		return Enqueue({ std::move(texts), a_speaker, a_target, a_type, {}, false });
+	}
+
+	LuaWorkerPool::Result LuaWorkerPool::Submit(std::vector<std::string> a_texts, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type, std::function<void()> a_onDone)
+	{
+		return Enqueue({ std::move(a_texts), a_speaker, a_target, a_type, std::move(a_onDone), true });
+	}
+
+	LuaWorkerPool::Result LuaWorkerPool::Enqueue(Job a_job)
+	{
+		auto ret = a_job.result.get_future();
+		{
+			std::unique_lock lock{ _lock };
+			_jobs.push_back(std::move(a_job));
+		}
+		_wake.notify_one();
+		Stats::Add(Stats::workerJobs);
+		return ret;
+	}
+
+	void LuaWorkerPool::Run(std::stop_token a_stop, std::latch& a_ready)
+	{
+		std::optional<LuaData> state{};
+		bool failed = false;
+		try {
+			auto& lua = state.emplace(true);
+			for (const auto& [replacement, bytecode] : _scripts) {
+				if (!lua.InitializeEnvironment(replacement, bytecode)) {
+					logger::error("Failed to initialize script {} on a worker", replacement.GetScript());
+				}
+			}
+			lua.BuildPipelines();
+		} catch (const std::exception& e) {
+			logger::error("Failed to set up a Lua worker - {}", e.what());
+			failed = true;
+		} catch (...) {
+			logger::error("Failed to set up a Lua worker");
+			failed = true;
+		}
+		// Start waits for every worker, a failed one still has to count down
+		if (failed) {
+			_failed++;
+		}
+		a_ready.count_down();
+		if (failed) {
+			return;
+		}
+		auto& lua = *state;
+		while (!a_stop.stop_requested()) {
+			std::unique_lock lock{ _lock };
+			if (!_wake.wait(lock, a_stop, [this] { return !_jobs.empty(); })) {
+				break;
+			}
+			auto job = std::move(_jobs.front());
+			_jobs.pop_front();
+			lock.unlock();
+
+			lua.ResetMemo();
+			if (!job.batch) {
+				lua.Apply(job.texts.front(), lua.ScanTriggers(job.texts, job.type), job.speaker, job.target, job.type);
+			} else {
+				lua.Apply(job.texts, lua.ScanTriggers(job.texts, job.type), job.speaker, job.target, job.type);
+			}
+			job.result.set_value(std::move(job.texts));
+			if (job.onDone) {
+				job.onDone();
+			}
+			// the worker is idle until the next job, which makes this the cheapest point to collect
+			if (lua.NeedsCollection()) {
+				lua.CollectGarbage(Settings::gcStepTime);
+			}
+		}
+	}
+}	 // namespace DDR
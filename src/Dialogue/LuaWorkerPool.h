@@ -0,0 +1,66 @@
+#pragma once
+
+#include <latch>
+
+#include "LuaData.h"
+
+namespace DDR
+{
+	/// @brief Runs pure scripts on worker threads, each with a private sandboxed Lua state
+	/// Workers load the same pure scripts in the same order as the main state, so a job yields the same text as running it inline
+	class LuaWorkerPool
+	{
+	public:
+		using Result = std::future<std::vector<std::string>>;
+
+		LuaWorkerPool() = default;
+		~LuaWorkerPool() { Stop(); }
+
+		LuaWorkerPool(const LuaWorkerPool&) = delete;
+		LuaWorkerPool& operator=(const LuaWorkerPool&) = delete;
+
+		/// @brief Register a pure script. a_bytecode may be empty, the script is then loaded from source. Only valid before Start()
+		void AddScript(TextReplacement a_replacement, std::string a_bytecode);
+		/// @brief Spawn a_count workers and wait until all of them loaded their scripts. Does nothing if no script was added
+		/// If any worker fails to set up its state, the pool is stopped again and scripts keep running on the calling thread
+		void Start(size_t a_count);
+		void Stop();
+
+		_NODISCARD bool IsRunning() const { return !_workers.empty(); }
+
+		/// @brief Queue a single line to be threaded through the pure scripts with replace()
+		Result Submit(std::string a_text, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type);
+		/// @brief Queue a list of lines to be threaded through the pure scripts, using replace_batch where scripts define it
+		/// @param a_onDone called on the worker once the result is available
+		Result Submit(std::vector<std::string> a_texts, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type, std::function<void()> a_onDone = {});
+
+	private:
+		struct Script
+		{
+			TextReplacement replacement;
+			std::string bytecode;
+		};
+
+		struct Job
+		{
+			std::vector<std::string> texts;
+			RE::FormID speaker;
+			RE::FormID target;
+			ReplacementType type;
+			std::function<void()> onDone;
+			bool batch;
+			std::promise<std::vector<std::string>> result{};
+		};
+
+		Result Enqueue(Job a_job);
+		void Run(std::stop_token a_stop, std::latch& a_ready);
+
+	private:
+		std::vector<Script> _scripts{};
+		std::deque<Job> _jobs{};
+		std::mutex _lock{};
+		std::condition_variable_any _wake{};
+		std::vector<std::jthread> _workers{};
+		std::atomic<size_t> _failed{ 0 };	 // workers whose setup threw, Start disables the pool if there are any
+	};
+}	 // namespace DDR
@@ -0,0 +1,64 @@
+#include "NativeReplacer.h"
+
+namespace DDR
+{
+	NativeReplacer::NativeReplacer(const DDR_TextReplacerInfo& a_info) :
+		_name(a_info.name ? a_info.name : ""),
+		_callback(a_info.callback),
+		_user(a_info.user),
+		_speakerId(a_info.speaker),
+		_targetId(a_info.target),
+		_type(magic_enum::enum_cast<ReplacementType>(static_cast<int>(a_info.type)).value_or(ReplacementType::Total)),
+		_priority(a_info.priority)
+	{
+		if (!_callback) {
+			throw std::runtime_error("Missing callback");
+		}
+		if (_type == ReplacementType::Total) {
+			throw std::runtime_error(std::format("Invalid replacement type {}", static_cast<int>(a_info.type)));
+		}
+	}
+
+	bool NativeReplacer::CanApplyReplacement(RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type) const
+	{
+		if (_type != ReplacementType::Any && _type != a_type)
+			return false;
+		if (_speakerId != 0 && a_speaker != _speakerId)
+			return false;
+		if (_targetId != 0 && a_target != _targetId)
+			return false;
+		return true;
+	}
+
+	bool NativeReplacer::Apply(std::string& a_text, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type) const
+	{
+		// replacers write into a per thread scratch buffer, which only ever grows
+		thread_local std::string buffer{};
+		if (buffer.size() < a_text.size() + 256) {
+			buffer.resize(a_text.size() + 256);
+		}
+		const DDR_TextContext context{ a_speaker, a_target, static_cast<DDR_ReplacementType>(std::to_underlying(a_type)) };
+		const DDR_StringView text{ a_text.data(), a_text.size() };
+		auto size = _callback(_user, std::addressof(context), text, buffer.data(), buffer.size());
+		if (size != DDR_NO_TEXT && size > buffer.size()) {
+			buffer.resize(size);
+			size = _callback(_user, std::addressof(context), text, buffer.data(), buffer.size());
+			if (size != DDR_NO_TEXT && size > buffer.size()) {
+				logger::error("Native replacer {} asked for a larger buffer twice, original text kept", _name);
+				return false;
+			}
+		}
+		if (size == DDR_NO_TEXT) {
+			return false;
+		}
+		a_text.assign(buffer.data(), size);
+		return true;
+	}
+
+	void NativeReplacer::Apply(std::vector<std::string>& a_texts, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type) const
+	{
+		for (auto& text : a_texts) {
+			Apply(text, a_speaker, a_target, a_type);
+		}
+	}
+}	 // namespace DDR
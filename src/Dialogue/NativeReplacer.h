@@ -0,0 +1,32 @@
+#pragma once
+
+#include "API/DDRAPI.h"
+#include "TextReplacement.h"
+
+namespace DDR
+{
+	/// @brief A text replacer registered by another plugin through the native interface
+	class NativeReplacer
+	{
+	public:
+		/// @brief Throws if a_info is incomplete
+		explicit NativeReplacer(const DDR_TextReplacerInfo& a_info);
+
+		_NODISCARD std::string_view GetName() const { return _name; }
+		_NODISCARD int32_t GetPriority() const { return _priority; }
+		_NODISCARD bool CanApplyReplacement(RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type) const;
+
+		/// @brief Run the replacer on a line. @return false if the text was kept
+		bool Apply(std::string& a_text, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type) const;
+		void Apply(std::vector<std::string>& a_texts, RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type) const;
+
+	private:
+		std::string _name;
+		DDR_TextReplacerFn _callback;
+		void* _user;
+		RE::FormID _speakerId;
+		RE::FormID _targetId;
+		ReplacementType _type;
+		int32_t _priority;
+	};
+}	 // namespace DDR
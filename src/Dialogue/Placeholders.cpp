@@ -0,0 +1,122 @@
+#include "Placeholders.h"
+
+namespace DDR
+{
+	bool PlaceholderValues::Bind(RE::TESObjectREFR* a_speaker, RE::TESObjectREFR* a_target)
+	{
+		const auto session = _session.load();
+		if (_speaker == a_speaker && _target == a_target && _boundSession == session) {
+			return false;
+		}
+		Reset();
+		_speaker = a_speaker;
+		_target = a_target;
+		_boundSession = session;
+		return true;
+	}
+
+	void PlaceholderValues::Reset()
+	{
+		_speaker = nullptr;
+		_target = nullptr;
+		_values = {};
+	}
+
+	std::string_view PlaceholderValues::Resolve(Placeholder a_placeholder)
+	{
+		auto& value = _values[a_placeholder.GetIndex()];
+		if (!value) {
+			RE::TESObjectREFR* subject = nullptr;
+			switch (a_placeholder.subject) {
+			case Placeholder::Subject::Speaker:
+				subject = _speaker;
+				break;
+			case Placeholder::Subject::Target:
+				subject = _target;
+				break;
+			case Placeholder::Subject::Player:
+				subject = RE::PlayerCharacter::GetSingleton();
+				break;
+			}
+			value = Lookup(subject, a_placeholder.property);
+		}
+		return *value;
+	}
+
+	std::string PlaceholderValues::Lookup(RE::TESObjectREFR* a_subject, Placeholder::Property a_property)
+	{
+		if (!a_subject) {
+			return "";
+		}
+		const auto actor = a_subject->As<RE::Actor>();
+		const char* ret = nullptr;
+		switch (a_property) {
+		case Placeholder::Property::Name:
+			ret = a_subject->GetDisplayFullName();
+			break;
+		case Placeholder::Property::Race:
+			if (const auto race = actor ? actor->GetRace() : nullptr) {
+				ret = race->GetFullName();
+			}
+			break;
+		case Placeholder::Property::Class:
+			if (const auto base = actor ? actor->GetActorBase() : nullptr; base && base->npcClass) {
+				ret = base->npcClass->GetFullName();
+			}
+			break;
+		}
+		return ret ? ret : "";
+	}
+
+	PlaceholderText::PlaceholderText(std::string a_text) :
+		_source(std::move(a_text))
+	{
+		const std::string_view text{ _source };
+		size_t literal = 0;	 // start of the pending literal run
+		size_t pos = 0;
+		while ((pos = text.find('{', pos)) != std::string_view::npos) {
+			const auto close = text.find_first_of("{}", pos + 1);
+			if (close == std::string_view::npos || text[close] != '}') {
+				pos = close;
+				continue;
+			}
+			const auto token = text.substr(pos + 1, close - pos - 1);
+			const auto dot = token.find('.');
+			const auto subject = magic_enum::enum_cast<Placeholder::Subject>(token.substr(0, dot), magic_enum::case_insensitive);
+			const auto property = dot != std::string_view::npos ? magic_enum::enum_cast<Placeholder::Property>(token.substr(dot + 1), magic_enum::case_insensitive) : std::nullopt;
+			if (!subject || !property) {
+				if (dot != std::string_view::npos) {
+					logger::warn("Unknown placeholder {{{}}} in '{}', kept as written", token, _source);
+				}
+				pos = close + 1;
+				continue;
+			}
+			_literals.append(text.substr(literal, pos - literal));
+			_segments.emplace_back(static_cast<uint32_t>(pos - literal), Placeholder{ *subject, *property });
+			pos = literal = close + 1;
+		}
+		if (_segments.empty()) {
+			_literals.clear();
+			return;
+		}
+		_literals.append(text.substr(literal));
+	}
+
+	std::string PlaceholderText::Expand(PlaceholderValues& a_values) const
+	{
+		if (_segments.empty()) {
+			return _source;
+		}
+		std::string ret{};
+		ret.reserve(_source.size() + _segments.size() * 16);
+		const std::string_view literals{ _literals };
+		size_t pos = 0;
+		for (const auto& [length, placeholder] : _segments) {
+			ret.append(literals.substr(pos, length));
+			ret.append(a_values.Resolve(placeholder));
+			pos += length;
+		}
+		ret.append(literals.substr(pos));
+		return ret;
+	}
+}	 // namespace DDR
@@ -0,0 +1,81 @@
+#pragma once
+
+namespace DDR
+{
+	/// @brief A token in a replacement text, written as {subject.property}, e.g. {speaker.name}
+	struct Placeholder
+	{
+		enum class Subject : uint8_t
+		{
+			Speaker,
+			Target,
+			Player,
+		};
+
+		enum class Property : uint8_t
+		{
+			Name,
+			Race,
+			Class,
+		};
+
+		static constexpr size_t COUNT = magic_enum::enum_count<Subject>() * magic_enum::enum_count<Property>();
+
+		Subject subject;
+		Property property;
+
+		_NODISCARD size_t GetIndex() const { return magic_enum::enum_integer(subject) * magic_enum::enum_count<Property>() + magic_enum::enum_integer(property); }
+	};
+
+	/// @brief Placeholder values for one speaker and target, each resolved on first use
+	class PlaceholderValues
+	{
+	public:
+		/// @brief Resolve future placeholders against a_speaker and a_target. Cached values are kept if neither changed and no new session began
+		/// @return true if cached values were dropped
+		bool Bind(RE::TESObjectREFR* a_speaker, RE::TESObjectREFR* a_target);
+		void Reset();
+		/// @brief Drop the cached values of every instance on its next Bind. Called whenever the dialogue menu opens or closes
+		static void BeginSession() { _session++; }
+
+		_NODISCARD std::string_view Resolve(Placeholder a_placeholder);
+
+	private:
+		static std::string Lookup(RE::TESObjectREFR* a_subject, Placeholder::Property a_property);
+
+		RE::TESObjectREFR* _speaker{ nullptr };
+		RE::TESObjectREFR* _target{ nullptr };
+		uint32_t _boundSession{ 0 };
+		std::array<std::optional<std::string>, Placeholder::COUNT> _values{};
+
+		static inline std::atomic<uint32_t> _session{ 0 };
+	};
+
+	/// @brief A replacement text, compiled into literal segments and placeholders when it is loaded
+	/// Braces which do not form a known placeholder are kept as written
+	class PlaceholderText
+	{
+	public:
+		PlaceholderText() = default;
+		explicit PlaceholderText(std::string a_text);
+
+		_NODISCARD bool empty() const { return _source.empty(); }
+		_NODISCARD bool HasPlaceholders() const { return !_segments.empty(); }
+		/// @brief The text as written, placeholders not expanded
+		_NODISCARD const std::string& GetSource() const { return _source; }
+		/// @brief The text with every placeholder replaced, in a single pass
+		_NODISCARD std::string Expand(PlaceholderValues& a_values) const;
+
+	private:
+		/// @brief A literal run of _literals followed by a placeholder
+		struct Segment
+		{
+			uint32_t length;
+			Placeholder placeholder;
+		};
+
+		std::string _source{};
+		std::string _literals{};	// all literal runs, back to back
+		std::vector<Segment> _segments{};
+	};
+}	 // namespace DDR
@@ -0,0 +1,364 @@
+#include "ReplacementFile.h"
+
+#include <spanstream>
+#include <yaml-cpp/eventhandler.h>
+
+#include "Util/MappedFile.h"
+
+namespace YAML
+{
+	template <>
+	struct convert<DDR::Response>
+	{
+		static bool decode(const Node& node, DDR::Response& rhs)
+		{
+			if (!node.IsMap()) {
+				return false;
+			}
+			for (const auto& it : node) {
+				const auto key = it.first.as<std::string>("");
+				if (it.second.IsScalar() && !rhs.SetField(key, it.second.Scalar())) {
+					logger::warn("Line {}: Unknown response field or invalid value '{}: {}', ignored", 1 + it.second.Mark().line, key, it.second.Scalar());
+				} else if (!it.second.IsNull() && !it.second.IsScalar()) {
+					logger::warn("Line {}: Unknown or invalid response field '{}', ignored", 1 + it.second.Mark().line, key);
+				}
+			}
+			return true;
+		}
+	};
+}	 // namespace YAML
+
+namespace
+{
+	using namespace DDR;
+
+	template <class T>
+	bool DecodeFields(const YAML::Node& a_node, T& a_data)
+	{
+		if (!a_node.IsMap()) {
+			return false;
+		}
+		for (const auto& it : a_node) {
+			const auto key = it.first.as<std::string>("");
+			const auto& value = it.second;
+			bool known = false;
+			if (value.IsScalar()) {
+				if (!a_data.SetField(key, value.Scalar())) {
+					logger::warn("Line {}: Unknown field or invalid value '{}: {}', ignored", 1 + value.Mark().line, key, value.Scalar());
+				}
+				continue;
+			} else if (value.IsSequence()) {
+				if constexpr (std::is_same_v<T, TopicInfo::Data>) {
+					if (key == "responses") {
+						a_data.responses = value.as<std::vector<Response>>();
+						continue;
+					}
+				}
+				if (const auto list = a_data.GetList(key)) {
+					*list = value.as<std::vector<std::string>>();
+					known = true;
+				}
+			} else if (value.IsNull()) {
+				known = true;
+			}
+			if (!known) {
+				logger::warn("Line {}: Unknown or invalid field '{}', ignored", 1 + value.Mark().line, key);
+			}
+		}
+		return true;
+	}
+}
+
+namespace YAML
+{
+	template <>
+	struct convert<DDR::TopicInfo::Data>
+	{
+		static bool decode(const Node& node, DDR::TopicInfo::Data& rhs) { return DecodeFields(node, rhs); }
+	};
+
+	template <>
+	struct convert<DDR::Topic::Data>
+	{
+		static bool decode(const Node& node, DDR::Topic::Data& rhs) { return DecodeFields(node, rhs); }
+	};
+
+	template <>
+	struct convert<DDR::TextReplacement::Data>
+	{
+		static bool decode(const Node& node, DDR::TextReplacement::Data& rhs) { return DecodeFields(node, rhs); }
+	};
+}	 // namespace YAML
+
+namespace DDR
+{
+	namespace
+	{
+		/// @brief Thrown by the stream handler on the first alias, the file is then read by the document loader which resolves anchors
+		struct AliasFound
+		{
+			int line;
+		};
+
+		/// @brief Builds the records of a replacement file directly from parser events
+		/// Accepts the same fields as the document loader. Unknown fields and misplaced values are reported and skipped
+		class StreamHandler final : public YAML::EventHandler
+		{
+			enum class Context
+			{
+				Root,
+				RefMap,
+				TopicInfos,
+				TopicInfo,
+				Responses,
+				Response,
+				Topics,
+				Topic,
+				Scripts,
+				Script,
+				List,
+				Skip
+			};
+
+			struct Frame
+			{
+				Context context;
+				std::string key{};		// key awaiting its value, if hasKey
+				bool hasKey{ false };
+				std::vector<std::string>* list{ nullptr };
+			};
+
+		public:
+			StreamHandler(ReplacementFile& a_file, std::string a_fileName) :
+				_file(a_file), _fileName(std::move(a_fileName)) {}
+
+			void OnDocumentStart(const YAML::Mark&) override {}
+			void OnDocumentEnd() override {}
+			void OnNull(const YAML::Mark& a_mark, YAML::anchor_t) override { OnValue(a_mark, nullptr); }
+			void OnAlias(const YAML::Mark& a_mark, YAML::anchor_t) override { throw AliasFound{ a_mark.line }; }
+			void OnScalar(const YAML::Mark& a_mark, const std::string&, YAML::anchor_t, const std::string& a_value) override { OnValue(a_mark, std::addressof(a_value)); }
+			void OnSequenceStart(const YAML::Mark& a_mark, const std::string&, YAML::anchor_t, YAML::EmitterStyle::value) override { Push(a_mark, false); }
+			void OnSequenceEnd() override { _stack.pop_back(); }
+			void OnMapStart(const YAML::Mark& a_mark, const std::string&, YAML::anchor_t, YAML::EmitterStyle::value) override { Push(a_mark, true); }
+			void OnMapEnd() override { _stack.pop_back(); }
+
+		private:
+			static bool IsMap(Context a_context)
+			{
+				switch (a_context) {
+				case Context::Root:
+				case Context::RefMap:
+				case Context::TopicInfo:
+				case Context::Response:
+				case Context::Topic:
+				case Context::Script:
+					return true;
+				default:
+					return false;
+				}
+			}
+
+			void Warn(const YAML::Mark& a_mark, std::string_view a_message) const
+			{
+				logger::warn("{}, line {}: {}", _fileName, 1 + a_mark.line, a_message);
+			}
+
+			void OnValue(const YAML::Mark& a_mark, const std::string* a_value)
+			{
+				if (_stack.empty()) {
+					throw std::runtime_error("Expected a map at the document root");
+				}
+				auto& top = _stack.back();
+				if (top.context == Context::Skip) {
+					return;
+				}
+				if (top.context == Context::List) {
+					if (a_value) {
+						top.list->push_back(*a_value);
+					}
+					return;
+				}
+				if (!IsMap(top.context)) {
+					Warn(a_mark, "Expected a map entry, value ignored");
+					return;
+				}
+				if (!top.hasKey) {
+					top.key = a_value ? *a_value : "";
+					top.hasKey = true;
+					return;
+				}
+				top.hasKey = false;
+				if (a_value && !SetField(top, *a_value)) {
+					Warn(a_mark, std::format("Unknown field or invalid value '{}: {}', ignored", top.key, *a_value));
+				}
+			}
+
+			bool SetField(const Frame& a_frame, const std::string& a_value)
+			{
+				switch (a_frame.context) {
+				case Context::RefMap:
+					_file.refMap[a_frame.key] = a_value;
+					return true;
+				case Context::TopicInfo:
+					return _file.topicInfos.back().data.SetField(a_frame.key, a_value);
+				case Context::Response:
+					return _file.topicInfos.back().data.responses.back().SetField(a_frame.key, a_value);
+				case Context::Topic:
+					return _file.topics.back().data.SetField(a_frame.key, a_value);
+				case Context::Script:
+					return _file.scripts.back().data.SetField(a_frame.key, a_value);
+				default:
+					return false;
+				}
+			}
+
+			void Push(const YAML::Mark& a_mark, bool a_isMap)
+			{
+				Frame frame{ Context::Skip };
+				if (_stack.empty()) {
+					if (a_isMap) {
+						frame.context = Context::Root;
+					} else {
+						Warn(a_mark, "Expected a map at the document root, file ignored");
+					}
+				} else if (auto& parent = _stack.back(); parent.context == Context::Skip) {
+					// nested in an ignored value
+				} else if (IsMap(parent.context)) {
+					if (!parent.hasKey) {
+						Warn(a_mark, "Complex keys are not supported, entry ignored");
+						parent.key.clear();
+						parent.hasKey = true;
+					} else {
+						parent.hasKey = false;
+						frame = Nested(parent, a_isMap);
+						if (frame.context == Context::Skip) {
+							Warn(a_mark, std::format("Unknown or invalid field '{}', ignored", parent.key));
+						}
+					}
+				} else {
+					frame = Element(parent, a_mark, a_isMap);
+				}
+				_stack.push_back(std::move(frame));
+			}
+
+			/// @brief A collection as the value of a map key
+			Frame Nested(const Frame& a_parent, bool a_isMap)
+			{
+				const auto& key = a_parent.key;
+				std::vector<std::string>* list = nullptr;
+				switch (a_parent.context) {
+				case Context::Root:
+					if (a_isMap && key == "refMap")
+						return { Context::RefMap };
+					if (!a_isMap && key == "topicInfos")
+						return { Context::TopicInfos };
+					if (!a_isMap && key == "topics")
+						return { Context::Topics };
+					if (!a_isMap && key == "scripts")
+						return { Context::Scripts };
+					break;
+				case Context::TopicInfo:
+					if (!a_isMap && key == "responses")
+						return { Context::Responses };
+					list = _file.topicInfos.back().data.GetList(key);
+					break;
+				case Context::Topic:
+					list = _file.topics.back().data.GetList(key);
+					break;
+				case Context::Script:
+					list = _file.scripts.back().data.GetList(key);
+					break;
+				default:
+					break;
+				}
+				if (list && !a_isMap) {
+					list->clear();
+					return { Context::List, "", false, list };
+				}
+				return { Context::Skip };
+			}
+
+			/// @brief A collection as an element of a sequence
+			Frame Element(const Frame& a_parent, const YAML::Mark& a_mark, bool a_isMap)
+			{
+				if (!a_isMap) {
+					Warn(a_mark, "Unexpected nested list, ignored");
+					return { Context::Skip };
+				}
+				switch (a_parent.context) {
+				case Context::TopicInfos:
+					_file.topicInfos.emplace_back(TopicInfo::Data{}, a_mark.line);
+					return { Context::TopicInfo };
+				case Context::Responses:
+					_file.topicInfos.back().data.responses.emplace_back();
+					return { Context::Response };
+				case Context::Topics:
+					_file.topics.emplace_back(Topic::Data{}, a_mark.line);
+					return { Context::Topic };
+				case Context::Scripts:
+					_file.scripts.emplace_back(TextReplacement::Data{}, a_mark.line);
+					return { Context::Script };
+				default:
+					Warn(a_mark, "Unexpected map in list, ignored");
+					return { Context::Skip };
+				}
+			}
+
+			ReplacementFile& _file;
+			std::string _fileName;
+			std::vector<Frame> _stack{};
+		};
+	}
+
+	size_t ReplacementFile::GetConditionCount() const
+	{
+		size_t ret = 0;
+		for (const auto& record : topicInfos) {
+			ret += record.data.conditions.size();
+		}
+		for (const auto& record : topics) {
+			ret += record.data.conditions.size();
+		}
+		return ret;
+	}
+
+	ReplacementFile ReplacementFile::Stream(const fs::path& a_path)
+	{
+		ReplacementFile ret{};
+		const Util::MappedFile mapping{ a_path };
+		std::ispanstream stream{ mapping.data() };
+		YAML::Parser parser{ stream };
+		StreamHandler handler{ ret, a_path.filename().string() };
+		try {
+			parser.HandleNextDocument(handler);
+		} catch (const AliasFound& e) {
+			logger::info("Line {}: {} uses aliases, loading it as a document instead", 1 + e.line, a_path.filename().string());
+			return Load(a_path);
+		}
+		return ret;
+	}
+
+	ReplacementFile ReplacementFile::Load(const fs::path& a_path)
+	{
+		ReplacementFile ret{};
+		const auto root = YAML::LoadFile(a_path.string());
+		ret.refMap = root["refMap"].as<std::map<std::string, std::string>>(std::map<std::string, std::string>{});
+		const auto read = [&]<class T>(const char* a_key, std::vector<Record<T>>& a_records) {
+			const auto node = root[a_key];
+			if (!node.IsDefined() || !node.IsSequence()) {
+				return;
+			}
+			for (const auto&& it : node) {
+				try {
+					a_records.emplace_back(it.as<T>(), it.Mark().line);
+				} catch (std::exception& e) {
+					logger::info("Line {}: Failed to read {} entry - {}", 1 + it.Mark().line, a_key, e.what());
+				}
+			}
+		};
+		read("topicInfos", ret.topicInfos);
+		read("topics", ret.topics);
+		read("scripts", ret.scripts);
+		return ret;
+	}
+}	 // namespace DDR
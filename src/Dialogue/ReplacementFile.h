@@ -0,0 +1,32 @@
+#pragma once
+
+#include "TextReplacement.h"
+#include "Topic.h"
+#include "TopicInfo.h"
+
+namespace DDR
+{
+	/// @brief Contents of a replacement file as plain data, before any form is resolved
+	struct ReplacementFile
+	{
+		template <class T>
+		struct Record
+		{
+			T data;
+			int line;	 // 0-based line of the entry, for diagnostics
+		};
+
+		std::map<std::string, std::string> refMap{};
+		std::vector<Record<TopicInfo::Data>> topicInfos{};
+		std::vector<Record<Topic::Data>> topics{};
+		std::vector<Record<TextReplacement::Data>> scripts{};
+
+		/// @brief Number of condition strings over all response and topic records
+		_NODISCARD size_t GetConditionCount() const;
+
+		/// @brief Stream a memory mapped file through the yaml-cpp event parser, without building a node tree
+		static ReplacementFile Stream(const fs::path& a_path);
+		/// @brief Load the file as a yaml-cpp document
+		static ReplacementFile Load(const fs::path& a_path);
+	};
+}	 // namespace DDR
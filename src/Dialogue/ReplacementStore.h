@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Conditions/Conditional.h"
+
+namespace DDR
+{
+	/// @brief Index of a replacement record inside its store
+	using Handle = std::uint32_t;
+
+	/// @brief Hot data of a replacement, packed together so candidate scans stay in contiguous memory
+	struct Entry
+	{
+		enum Flag : std::uint32_t
+		{
+			kNone = 0,
+			kRandom = 1 << 0,
+			kPreProcessing = 1 << 1,
+		};
+
+		uint64_t priority;
+		const Conditions::Conditional* conditions;
+		Handle handle;
+		std::uint32_t flags;
+
+		_NODISCARD inline bool IsRandom() const { return (flags & kRandom) != 0; }
+		_NODISCARD inline bool HasPreProcessingAction() const { return (flags & kPreProcessing) != 0; }
+		_NODISCARD inline bool ConditionsMet(RE::TESObjectREFR* a_subject, RE::TESObjectREFR* a_target) const { return conditions->ConditionsMet(a_subject, a_target); }
+	};
+	static_assert(sizeof(Entry) == 24);
+
+	/// @brief Owns the cold replacement records of type T. Records are only appended while loading, handles stay valid afterwards
+	template <class T>
+	class RecordStore
+	{
+	public:
+		Handle Insert(T&& a_record)
+		{
+			_records.push_back(std::move(a_record));
+			return static_cast<Handle>(_records.size() - 1);
+		}
+
+		_NODISCARD T& operator[](Handle a_handle) { return _records[a_handle]; }
+		_NODISCARD const T& operator[](Handle a_handle) const { return _records[a_handle]; }
+		_NODISCARD size_t size() const { return _records.size(); }
+		void shrink_to_fit() { _records.shrink_to_fit(); }
+
+	private:
+		std::vector<T> _records;
+	};
+
+	/// @brief Maps a key to a contiguous, priority sorted range of hot entries
+	template <class K>
+	class ReplacementIndex
+	{
+		struct Range
+		{
+			std::uint32_t begin;
+			std::uint32_t end;
+		};
+
+	public:
+		/// @brief Register a record for the given key. Only valid before Finalize()
+		void Stage(const K& a_key, Handle a_handle) { _staged.emplace_back(a_key, a_handle); }
+
+		/// @brief Pack all staged records into a flat entry array, sorted by key and descending priority
+		template <class T>
+		void Finalize(const RecordStore<T>& a_records)
+		{
+			std::ranges::stable_sort(_staged, [&](const auto& a, const auto& b) {
+				if (a.first != b.first)
+					return a.first < b.first;
+				return a_records[a.second].GetPriority() > a_records[b.second].GetPriority();
+			});
+			_entries.clear();
+			_entries.reserve(_staged.size());
+			_ranges.clear();
+			_ranges.reserve(_staged.size());
+			for (const auto& [key, handle] : _staged) {
+				const auto& record = a_records[handle];
+				const auto idx = static_cast<std::uint32_t>(_entries.size());
+				_entries.push_back(Entry{ record.GetPriority(), std::addressof(record.GetConditions()), handle, record.GetFlags() });
+				auto [where, inserted] = _ranges.try_emplace(key, Range{ idx, idx });
+				where->second.end = idx + 1;
+			}
+			_staged.clear();
+			_staged.shrink_to_fit();
+		}
+
+		_NODISCARD std::span<const Entry> Find(const K& a_key) const
+		{
+			const auto where = _ranges.find(a_key);
+			if (where == _ranges.end()) {
+				return {};
+			}
+			return std::span<const Entry>{ _entries.data() + where->second.begin, _entries.data() + where->second.end };
+		}
+
+		_NODISCARD size_t size() const { return _entries.size(); }
+
+	private:
+		std::vector<std::pair<K, Handle>> _staged;
+		std::vector<Entry> _entries;
+		std::unordered_map<K, Range> _ranges;
+	};
+}	 // namespace DDR
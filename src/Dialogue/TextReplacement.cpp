@@ -1,35 +1,67 @@
 #include "TextReplacement.h"
 
+#include "Settings.h"
 #include "Util/FormLookup.h"
+#include "Util/Yaml.h"
 
 namespace DDR
 {
-	TextReplacement::TextReplacement(const YAML::Node& a_node) :
-		_script(a_node["script"].as<std::string>()),
-		_speakerId(Util::FormFromString(a_node["speaker"].as<std::string>(""))),
-		_targetId(Util::FormFromString(a_node["target"].as<std::string>(""))),
-		_type(magic_enum::enum_cast<ReplacementType>(a_node["type"].as<int>()).or_else([]() -> std::optional<ReplacementType> { 
+	bool TextReplacement::Data::SetField(std::string_view a_key, const std::string& a_value)
+	{
+		if (a_key == "script") {
+			script = a_value;
+		} else if (a_key == "speaker") {
+			speaker = a_value;
+		} else if (a_key == "target") {
+			target = a_value;
+		} else if (a_key == "type") {
+			return Util::DecodeScalar(a_value, type);
+		} else if (a_key == "budget") {
+			return Util::DecodeScalar(a_value, budget);
+		} else if (a_key == "timeout") {
+			return Util::DecodeScalar(a_value, timeout);
+		} else if (a_key == "pure") {
+			return Util::DecodeScalar(a_value, pure);
+		} else if (a_key == "priority") {
+			return Util::DecodeScalar(a_value, priority);
+		} else {
+			return false;
+		}
+		return true;
+	}
+
+	std::vector<std::string>* TextReplacement::Data::GetList(std::string_view a_key)
+	{
+		return a_key == "triggers" ? std::addressof(triggers) : nullptr;
+	}
+
+	TextReplacement::TextReplacement(Data a_data) :
+		_script(std::move(a_data.script)),
+		_speakerId(Util::FormFromString(a_data.speaker)),
+		_targetId(Util::FormFromString(a_data.target)),
+		_type(magic_enum::enum_cast<ReplacementType>(a_data.type.value_or(-1)).or_else([]() -> std::optional<ReplacementType> { 
       throw std::runtime_error("Property 'type' is missing or invalid");
-    }).value())
+    }).value()),
+		_instructionBudget(a_data.budget.value_or(Settings::scriptInstructionBudget)),
+		_timeBudget(a_data.timeout.value_or(Settings::scriptTimeBudget)),
+		_triggers(std::move(a_data.triggers)),
+		_pure(a_data.pure),
+		_priority(a_data.priority)
 	{
     if (_script.empty()) {
       throw std::runtime_error("Failed to load script");
     }
   }
 
-	bool TextReplacement::CanApplyReplacement(RE::TESObjectREFR* a_speaker, RE::TESObjectREFR* a_target, ReplacementType a_type) const
+	bool TextReplacement::CanApplyReplacement(RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type) const
   {
     if (_type != ReplacementType::Any && _type != a_type)
       return false;
-    if (_speakerId != 0) {
-      if (!a_speaker || a_speaker->GetFormID() != _speakerId) {
-        return false;
-      }
+    if (_speakerId != 0 && a_speaker != _speakerId) {
+      return false;
     }
-    if (_targetId != 0) {
-      if (!a_target || a_target->GetFormID() != _targetId) {
-        return false;
-      }
+    if (_targetId != 0 && a_target != _targetId) {
+      return false;
     }
     return true;
   }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Util/SubstringScanner.h"
+
 namespace DDR
 {
   enum class ReplacementType
@@ -13,17 +15,50 @@ namespace DDR
 
   struct TextReplacement
   {
-    TextReplacement(const YAML::Node& a_node);
+    /// @brief Raw fields of a scripts entry, as read from a replacement file
+    struct Data
+    {
+      std::string script{};
+      std::string speaker{};
+      std::string target{};
+      std::optional<int> type{};
+      std::optional<uint32_t> budget{};
+      std::optional<float> timeout{};
+      bool pure{ false };
+      int32_t priority{ 0 };
+      std::vector<std::string> triggers{};
+
+      /// @brief Assign a scalar field by its YAML key. @return false if the key is not a scalar field or the value does not convert
+      bool SetField(std::string_view a_key, const std::string& a_value);
+      /// @brief The list field for a YAML key, nullptr if the key is not a list field
+      std::vector<std::string>* GetList(std::string_view a_key);
+    };
+
+    TextReplacement(Data a_data);
     ~TextReplacement() = default;
 
     _NODISCARD std::string_view GetScript() const { return _script; }
-    _NODISCARD bool CanApplyReplacement(RE::TESObjectREFR* a_speaker, RE::TESObjectREFR* a_target, ReplacementType a_type) const;
+    _NODISCARD ReplacementType GetType() const { return _type; }
+    _NODISCARD uint32_t GetInstructionBudget() const { return _instructionBudget; }
+    _NODISCARD float GetTimeBudget() const { return _timeBudget; }
+    /// @brief If the script only depends on the text and ids it is given, and may run on a worker thread
+    _NODISCARD bool IsPure() const { return _pure; }
+    /// @brief Scripts and native replacers run from highest to lowest priority
+    _NODISCARD int32_t GetPriority() const { return _priority; }
+    _NODISCARD bool CanApplyReplacement(RE::FormID a_speaker, RE::FormID a_target, ReplacementType a_type) const;
+    /// @brief If the text contains one of the script's triggers. Scripts without triggers accept every text
+    _NODISCARD bool IsTriggeredBy(std::string_view a_text) const { return _triggers.Matches(a_text); }
 
   private:
 		std::string _script;
 		RE::FormID _speakerId;
 		RE::FormID _targetId;
 		ReplacementType _type;
+		uint32_t _instructionBudget;
+		float _timeBudget;
+		Util::SubstringScanner _triggers;
+		bool _pure;
+		int32_t _priority;
 
   public:
     bool operator<(const TextReplacement& a_rhs) const noexcept { return _script < a_rhs._script; };
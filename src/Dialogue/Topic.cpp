@@ -1,34 +1,64 @@
 #include "Topic.h"
 
+#include "Util/Yaml.h"
+
 namespace DDR
 {
-	Topic::Topic(const YAML::Node& a_node, const Conditions::RefMap& a_refMap) :
-		_id(a_refMap.LookupId(a_node["id"].as<std::string>(""))),
-		_affectedTopic(a_refMap.LookupId(a_node["affects"].as<std::string>(""))),
-		_replaceWith(a_refMap.LookupId(a_node["replace"].IsDefined() ? a_node["replace"].as<std::string>("") : a_node["with"].as<std::string>(""))),
-		_text(a_node["text"].as<std::string>("")),
-		_inject(a_node["inject"].as<std::vector<std::string>>(std::vector<std::string>{}) |
-						std::ranges::views::transform([&](const auto& str) { return a_refMap.Lookup<RE::TESTopic>(str); }) |
-						std::ranges::views::filter([](const auto it) { return it != nullptr; }) |
-						std::ranges::to<std::vector>()),
-		_conditions(Conditions::Conditional{ a_node["conditions"].as<std::vector<std::string>>(std::vector<std::string>{}), a_refMap }),
-		_priority(a_node["priority"].as<uint64_t>(0)),
-		_proceed(a_node["proceed"].as<std::string>("true") == "true" || a_node["proceed"].as<bool>(true)),
-		_check(a_node["check"].as<std::string>("") == "true" || a_node["check"].as<bool>(false)),
-		_hide(a_node["hide"].as<std::string>("") == "true" || a_node["hide"].as<bool>(false))
+	bool Topic::Data::SetField(std::string_view a_key, const std::string& a_value)
 	{
-		if (_id != 0 && !RE::TESForm::LookupByID<RE::TESTopic>(_id)) {
-			throw std::runtime_error("Invalid topic id");
-		}
-		if (_affectedTopic && !RE::TESForm::LookupByID<RE::TESTopic>(_affectedTopic)) {
-			throw std::runtime_error("Invalid affected topic id");
+		if (a_key == "id") {
+			id = a_value;
+		} else if (a_key == "affects") {
+			affects = a_value;
+		} else if (a_key == "replace") {
+			replace = a_value;
+			hasReplace = true;
+		} else if (a_key == "with") {
+			// alias of 'replace', which takes precedence wherever it appears, even if empty
+			if (!hasReplace)
+				replace = a_value;
+		} else if (a_key == "text") {
+			text = a_value;
+		} else if (a_key == "priority") {
+			return Util::DecodeScalar(a_value, priority);
+		} else if (a_key == "proceed") {
+			return Util::DecodeScalar(a_value, proceed);
+		} else if (a_key == "check") {
+			return Util::DecodeScalar(a_value, check);
+		} else if (a_key == "hide") {
+			return Util::DecodeScalar(a_value, hide);
+		} else {
+			return false;
 		}
-		if (_replaceWith) {
-			if (!RE::TESForm::LookupByID<RE::TESTopic>(_replaceWith)) {
-				throw std::runtime_error("Failed to obtain replacement topic");
-			} else if (!_affectedTopic) {
-				throw std::runtime_error("Missing affected topic. Replacement must specify a topic to replace");
-			} 
+		return true;
+	}
+
+	std::vector<std::string>* Topic::Data::GetList(std::string_view a_key)
+	{
+		if (a_key == "inject")
+			return std::addressof(inject);
+		if (a_key == "conditions")
+			return std::addressof(conditions);
+		return nullptr;
+	}
+
+	Topic::Topic(Data a_data, const Conditions::RefMap& a_refMap) :
+		_id(a_refMap.LookupId(a_data.id)),
+		_affectedTopic(a_refMap.LookupId(a_data.affects)),
+		_replaceWith(a_refMap.LookupId(a_data.replace)),
+		_text(std::move(a_data.text)),
+		_injectIds(a_data.inject |
+							 std::ranges::views::transform([&](const auto& str) { return a_refMap.LookupId(str); }) |
+							 std::ranges::views::filter([](const auto it) { return it != 0; }) |
+							 std::ranges::to<std::vector>()),
+		_conditions(Conditions::Conditional{ std::move(a_data.conditions), a_refMap }),
+		_priority(a_data.priority),
+		_proceed(a_data.proceed),
+		_check(a_data.check),
+		_hide(a_data.hide)
+	{
+		if (_replaceWith && !_affectedTopic) {
+			throw std::runtime_error("Missing affected topic. Replacement must specify a topic to replace");
 		}
 		if (_hide && _replaceWith) {
 			throw std::runtime_error("Replacement and hide cannot be used together");
@@ -36,19 +66,55 @@ namespace DDR
 		if (_hide && !_affectedTopic) {
 			throw std::runtime_error("Hide must specify a topic to hide");
 		}
-		if (!_inject.empty() && _id == 0) {
+		if (!_injectIds.empty() && _id == 0) {
 			throw std::runtime_error("Injection topics must specify a topic id");
 		}
-		if (_text.empty() && !_replaceWith && _inject.empty() && !_hide) {
+		if (_text.empty() && !_replaceWith && _injectIds.empty() && !_hide) {
 			throw std::runtime_error("Invalid topic: no text, replacement, injection, or hide flag specified. This topic does nothing.");
 		}
 	}
 
 	Topic::Topic(RE::FormID a_id, std::string a_text) :
-		_id(a_id), _text(a_text)
+		_id(a_id), _text(std::move(a_text))
 	{
 		if (_id == 0 || !RE::TESForm::LookupByID<RE::TESTopic>(_id)) {
 			throw std::runtime_error("Failed to obtain topic");
 		}
 	}
+
+	bool Topic::Bind(std::vector<std::string>& a_unresolved)
+	{
+		const auto unresolved = [&](std::string_view a_field, RE::FormID a_ref) {
+			a_unresolved.push_back(std::format("Topic 0x{:X}: {} 0x{:X} does not resolve to a topic", _id ? _id : _affectedTopic, a_field, a_ref));
+		};
+		bool valid = true;
+		if (_id != 0 && !RE::TESForm::LookupByID<RE::TESTopic>(_id)) {
+			unresolved("id", _id);
+			valid = false;
+		}
+		if (_affectedTopic && !RE::TESForm::LookupByID<RE::TESTopic>(_affectedTopic)) {
+			unresolved("affected topic", _affectedTopic);
+			valid = false;
+		}
+		if (_replaceWith) {
+			_replacingTopic = RE::TESForm::LookupByID<RE::TESTopic>(_replaceWith);
+			if (!_replacingTopic) {
+				unresolved("replacement topic", _replaceWith);
+				valid = false;
+			}
+		}
+		_inject.clear();
+		for (const auto& injectId : _injectIds) {
+			if (const auto topic = RE::TESForm::LookupByID<RE::TESTopic>(injectId)) {
+				_inject.push_back(topic);
+			} else {
+				unresolved("injected topic", injectId);
+			}
+		}
+		if (valid && _text.empty() && !_replaceWith && _inject.empty() && !_hide) {
+			a_unresolved.push_back(std::format("Topic 0x{:X}: no injected topic could be resolved, replacement does nothing", _id));
+			valid = false;
+		}
+		return valid;
+	}
 }	 // namespace DDR
@@ -2,6 +2,8 @@
 
 #include "Conditions/RefMap.h"
 #include "Conditions/Conditional.h"
+#include "Placeholders.h"
+#include "ReplacementStore.h"
 #include "Util/FormLookup.h"
 
 namespace DDR
@@ -9,39 +11,67 @@ namespace DDR
 	class Topic
 	{
 	public:
-		Topic(const YAML::Node& a_node, const Conditions::RefMap& a_refMap);
+		/// @brief Raw fields of a topics entry, as read from a replacement file
+		struct Data
+		{
+			std::string id{};
+			std::string affects{};
+			std::string replace{};
+			std::string text{};
+			std::vector<std::string> inject{};
+			std::vector<std::string> conditions{};
+			uint64_t priority{ 0 };
+			bool proceed{ true };
+			bool check{ false };
+			bool hide{ false };
+			bool hasReplace{ false };	 // 'replace' was given, the 'with' alias is ignored
+
+			/// @brief Assign a scalar field by its YAML key. @return false if the key is not a scalar field or the value does not convert
+			bool SetField(std::string_view a_key, const std::string& a_value);
+			/// @brief The list field for a YAML key, nullptr if the key is not a list field
+			std::vector<std::string>* GetList(std::string_view a_key);
+		};
+
+		Topic(Data a_data, const Conditions::RefMap& a_refMap);
 		Topic(RE::FormID a_id, std::string a_text);
-		~Topic() = default;
+
+		/// @brief Resolve all referenced forms. Unresolved references are appended to a_unresolved
+		/// @return false if the replacement is unusable without the unresolved forms
+		bool Bind(std::vector<std::string>& a_unresolved);
 
 		/// @brief FormID of the affected topic
-		_NODISCARD RE::FormID GetId() { return _id; }
-		_NODISCARD RE::FormID GetAffectedTopic() { return _affectedTopic; }
+		_NODISCARD RE::FormID GetId() const { return _id; }
+		_NODISCARD RE::FormID GetAffectedTopic() const { return _affectedTopic; }
 		/// @brief Check if the topic is affected by the replacement
-		_NODISCARD bool AffectsInfoTopic(RE::TESTopic* a_topic) { return a_topic->formID == _affectedTopic; }
+		_NODISCARD bool AffectsInfoTopic(RE::TESTopic* a_topic) const { return a_topic->formID == _affectedTopic; }
 		/// @brief Player response to replace the topic with
-		_NODISCARD std::string GetText() { return _text; }
+		_NODISCARD const PlaceholderText& GetText() const { return _text; }
 		/// @brief If the topic should be hidden (no responses available)
-		_NODISCARD bool IsHidden() { return _hide; }
+		_NODISCARD bool IsHidden() const { return _hide; }
 		/// @brief Is this topic relevant when pre-processing the affected dialogue topic
-		_NODISCARD bool HasPreProcessingAction() { return _replaceWith || _hide || !_inject.empty(); }
+		_NODISCARD bool HasPreProcessingAction() const { return _replaceWith || _hide || !_inject.empty(); }
 		/// @brief If default processing should continue after edits have been applied (implied true on replacement and false on hide)
-		_NODISCARD bool ShouldProceed() { return _proceed; }
+		_NODISCARD bool ShouldProceed() const { return _proceed; }
 		/// @brief The topic to replace the affected topic with
-		_NODISCARD RE::TESTopic* GetReplacingTopic() { return RE::TESForm::LookupByID<RE::TESTopic>(_replaceWith); }
+		_NODISCARD RE::TESTopic* GetReplacingTopic() const { return _replacingTopic; }
 		/// @brief Additional response topics to inject into the dialogue
-		_NODISCARD const std::vector<RE::TESTopic*>& GetInjections() { return _inject; }
+		_NODISCARD const std::vector<RE::TESTopic*>& GetInjections() const { return _inject; }
 		/// @brief Verify existing conditions met before applying any overrides
-		_NODISCARD bool VerifyExistingConditions() { return _check; }
+		_NODISCARD bool VerifyExistingConditions() const { return _check; }
 		/// @brief Check if the conditions are met
-		_NODISCARD bool ConditionsMet(RE::TESObjectREFR* a_speaker, RE::TESObjectREFR* a_target) { return _conditions.ConditionsMet(a_speaker, a_target); }
+		_NODISCARD bool ConditionsMet(RE::TESObjectREFR* a_speaker, RE::TESObjectREFR* a_target) const { return _conditions.ConditionsMet(a_speaker, a_target); }
 		/// @brief ¯\_(ツ)_/¯
-		_NODISCARD uint64_t GetPriority() { return _priority; }
+		_NODISCARD uint64_t GetPriority() const { return _priority; }
+		_NODISCARD const Conditions::Conditional& GetConditions() const { return _conditions; }
+		_NODISCARD std::uint32_t GetFlags() const { return HasPreProcessingAction() ? Entry::kPreProcessing : Entry::kNone; }
 
 	private:
 		RE::FormID _id;
 		RE::FormID _affectedTopic{ 0 };
 		RE::FormID _replaceWith{ 0 };
-		std::string _text{ "" };
+		RE::TESTopic* _replacingTopic{ nullptr };
+		PlaceholderText _text{};
+		std::vector<RE::FormID> _injectIds{};
 		std::vector<RE::TESTopic*> _inject{};
 		Conditions::Conditional _conditions{};
 		uint64_t _priority{ 0 };
@@ -1,18 +1,61 @@
 #include "TopicInfo.h"
 
+#include "Util/Yaml.h"
+
 namespace DDR
 {
-	TopicInfo::TopicInfo(const YAML::Node& a_node, const Conditions::RefMap& a_refMap) :
-		_topicInfoId(a_refMap.LookupId(a_node["id"].as<std::string>())),
-		_responses(a_node["responses"].as<std::vector<Response>>(std::vector<Response>{})),
-		_priority(a_node["priority"].as<uint64_t>(0)),
-		_conditions(Conditions::Conditional{ a_node["conditions"].as<std::vector<std::string>>(std::vector<std::string>{}), a_refMap }),
-		_voiceTypes(a_node["voices"].as<std::vector<std::string>>(std::vector<std::string>{}) |
-								std::ranges::views::transform([](const auto& str) { return RE::TESForm::LookupByEditorID<RE::BGSVoiceType>(str); }) |
-								std::ranges::views::filter([](const auto it) { return it != nullptr; }) |
-								std::ranges::to<std::vector>()),
-		_random(a_node["random"].as<std::string>("") == "true" || a_node["random"].as<bool>(false)),
-		_cut(a_node["cut"].as<std::string>("true") == "true" || a_node["cut"].as<bool>(true))
+	bool Response::SetField(std::string_view a_key, const std::string& a_value)
+	{
+		if (a_key == "subtitle") {
+			subtitle = a_value;
+			hasSubtitle = true;
+		} else if (a_key == "sub") {
+			// short form, 'subtitle' takes precedence wherever it appears, even if empty
+			if (!hasSubtitle)
+				subtitle = a_value;
+		} else if (a_key == "path") {
+			filePath = a_value;
+		} else if (a_key == "keep") {
+			return Util::DecodeScalar(a_value, keep);
+		} else {
+			return false;
+		}
+		return true;
+	}
+
+	bool TopicInfo::Data::SetField(std::string_view a_key, const std::string& a_value)
+	{
+		if (a_key == "id") {
+			id = a_value;
+		} else if (a_key == "priority") {
+			return Util::DecodeScalar(a_value, priority);
+		} else if (a_key == "random") {
+			return Util::DecodeScalar(a_value, random);
+		} else if (a_key == "cut") {
+			return Util::DecodeScalar(a_value, cut);
+		} else {
+			return false;
+		}
+		return true;
+	}
+
+	std::vector<std::string>* TopicInfo::Data::GetList(std::string_view a_key)
+	{
+		if (a_key == "conditions")
+			return std::addressof(conditions);
+		if (a_key == "voices")
+			return std::addressof(voices);
+		return nullptr;
+	}
+
+	TopicInfo::TopicInfo(Data a_data, const Conditions::RefMap& a_refMap) :
+		_topicInfoId(a_refMap.LookupId(a_data.id)),
+		_responses(std::move(a_data.responses)),
+		_voiceTypeIds(std::move(a_data.voices)),
+		_conditions(Conditions::Conditional{ std::move(a_data.conditions), a_refMap }),
+		_priority(a_data.priority),
+		_random(a_data.random),
+		_cut(a_data.cut)
 	{
 		if (_topicInfoId == 0) {
 			throw std::runtime_error("Invalid topic info id");
@@ -21,25 +64,46 @@ namespace DDR
 			const auto err = std::format("Failed to find responses in replacement {}", _topicInfoId);
 			throw std::runtime_error(err.c_str());
 		}
+		_subtitles.reserve(_responses.size());
+		for (auto& response : _responses) {
+			_subtitles.emplace_back(std::exchange(response.subtitle, {}));
+		}
 	}
 
-	std::string TopicInfo::GenerateHash(RE::FormID a_id, const RE::BGSVoiceType* a_voiceType)
+	bool TopicInfo::Bind(std::vector<std::string>& a_unresolved)
 	{
-		if (!a_voiceType) {
-			return "";
+		_voiceTypes.clear();
+		_voiceTypes.reserve(_voiceTypeIds.size());
+		for (const auto& editorId : _voiceTypeIds) {
+			if (const auto voiceType = RE::TESForm::LookupByEditorID<RE::BGSVoiceType>(editorId)) {
+				_voiceTypes.push_back(voiceType);
+			} else {
+				a_unresolved.push_back(std::format("TopicInfo 0x{:X}: voice type '{}' does not exist", _topicInfoId, editorId));
+			}
 		}
-		return std::format("{}|{}", a_id, a_voiceType->GetFormEditorID());
+		if (!_voiceTypeIds.empty() && _voiceTypes.empty()) {
+			// without any voice type the replacement would silently apply to every voice
+			a_unresolved.push_back(std::format("TopicInfo 0x{:X}: none of the listed voice types exist, replacement ignored", _topicInfoId));
+			return false;
+		}
+		return true;
+	}
+
+	std::uint64_t TopicInfo::GenerateHash(RE::FormID a_id, const RE::BGSVoiceType* a_voiceType)
+	{
+		// no voice type is ever form 0, which leaves it to stand for all of them
+		return (static_cast<std::uint64_t>(a_id) << 32) | (a_voiceType ? a_voiceType->GetFormID() : 0);
 	}
 
-	std::string TopicInfo::GenerateHash(RE::FormID a_id)
+	std::uint64_t TopicInfo::GenerateHash(RE::FormID a_id)
 	{
-		return std::format("{}|all", a_id);
+		return GenerateHash(a_id, nullptr);
 	}
 
-	std::vector<std::string> TopicInfo::GetHashes() const
+	std::vector<std::uint64_t> TopicInfo::GetHashes() const
 	{
 		if (_voiceTypes.empty()) {
-			return std::vector<std::string>{ GenerateHash(_topicInfoId) };
+			return std::vector<std::uint64_t>{ GenerateHash(_topicInfoId) };
 		}
 		return _voiceTypes | std::ranges::views::transform([this](RE::BGSVoiceType* a_voiceType) {
 			return GenerateHash(_topicInfoId, a_voiceType);
@@ -2,6 +2,8 @@
 
 #include "Conditions/Conditional.h"
 #include "Conditions/RefMap.h"
+#include "Placeholders.h"
+#include "ReplacementStore.h"
 #include "Util/FormLookup.h"
 #include "Util/StringUtil.h"
 
@@ -9,35 +11,67 @@ namespace DDR
 {
 	struct Response
 	{
-		bool keep;
-		std::string subtitle;
-		std::string filePath;
+		bool keep{ false };
+		bool hasSubtitle{ false };	// 'subtitle' was given, the 'sub' alias is ignored
+		std::string subtitle{};
+		std::string filePath{};
+
+		/// @brief Assign a scalar field by its YAML key. @return false if the key is not a field of a response or the value does not convert
+		bool SetField(std::string_view a_key, const std::string& a_value);
 	};
 
 	class TopicInfo
 	{
 	public:
-		TopicInfo(const YAML::Node& a_node, const Conditions::RefMap& a_refMap);
-		~TopicInfo() = default;
+		/// @brief Raw fields of a topicInfos entry, as read from a replacement file
+		struct Data
+		{
+			std::string id{};
+			std::vector<Response> responses{};
+			std::vector<std::string> conditions{};
+			std::vector<std::string> voices{};
+			uint64_t priority{ 0 };
+			bool random{ false };
+			bool cut{ true };
+
+			/// @brief Assign a scalar field by its YAML key. @return false if the key is not a scalar field or the value does not convert
+			bool SetField(std::string_view a_key, const std::string& a_value);
+			/// @brief The list field for a YAML key, nullptr if the key is not a list field
+			std::vector<std::string>* GetList(std::string_view a_key);
+		};
 
-		_NODISCARD static std::string GenerateHash(RE::FormID a_id, const RE::BGSVoiceType* a_voiceType);
-		_NODISCARD static std::string GenerateHash(RE::FormID a_id);
-		_NODISCARD std::vector<std::string> GetHashes() const;
+		TopicInfo(Data a_data, const Conditions::RefMap& a_refMap);
 
+		/// @brief Resolve the listed voice types. Unresolved references are appended to a_unresolved
+		/// @return false if the replacement is unusable without the unresolved forms
+		bool Bind(std::vector<std::string>& a_unresolved);
+
+		/// @brief Index key of a response replacement, the topic info id packed with the voice type id
+		_NODISCARD static std::uint64_t GenerateHash(RE::FormID a_id, const RE::BGSVoiceType* a_voiceType);
+		/// @brief Index key of a response replacement for every voice type
+		_NODISCARD static std::uint64_t GenerateHash(RE::FormID a_id);
+		_NODISCARD std::vector<std::uint64_t> GetHashes() const;
+		_NODISCARD inline RE::FormID GetId() const { return _topicInfoId; }
+
+		_NODISCARD inline int GetResponseCount() const { return static_cast<int>(_responses.size()); }
 		_NODISCARD inline bool HasReplacement(int a_num) const { return a_num <= _responses.size() && !_responses[a_num - 1].keep; }
-		_NODISCARD inline bool HasReplacementSubtitle(int a_num) const { return HasReplacement(a_num) && !_responses[a_num - 1].subtitle.empty(); }
+		_NODISCARD inline bool HasReplacementSubtitle(int a_num) const { return HasReplacement(a_num) && !_subtitles[a_num - 1].empty(); }
 		_NODISCARD inline bool HasReplacementVoiceFile(int a_num) const { return HasReplacement(a_num) && !_responses[a_num - 1].filePath.empty(); }
 
 		_NODISCARD std::string GetVoiceFilePath(RE::TESTopic* a_topic, RE::TESTopicInfo* a_topicInfo, RE::BGSVoiceType* a_voiceType, int a_num) const;
-		_NODISCARD inline std::string GetSubtitle(int a_num) const { return _responses[a_num - 1].subtitle; }
+		_NODISCARD inline const PlaceholderText& GetSubtitle(int a_num) const { return _subtitles[a_num - 1]; }
 		_NODISCARD inline bool IsRandom() const { return _random; }
 		_NODISCARD inline uint64_t GetPriority() const { return _priority; }
 		_NODISCARD inline bool ShouldCut(int a_num) const { return _cut && a_num >= _responses.size(); }
 		_NODISCARD inline bool ConditionsMet(RE::TESObjectREFR* a_subject, RE::TESObjectREFR* a_target) const { return _conditions.ConditionsMet(a_subject, a_target); }
+		_NODISCARD inline const Conditions::Conditional& GetConditions() const { return _conditions; }
+		_NODISCARD inline std::uint32_t GetFlags() const { return _random ? Entry::kRandom : Entry::kNone; }
 
 	private:
 		RE::FormID _topicInfoId;
 		std::vector<Response> _responses;
+		std::vector<PlaceholderText> _subtitles{};	// by response, compiled from Response::subtitle
+		std::vector<std::string> _voiceTypeIds{};
 		std::vector<RE::BGSVoiceType*> _voiceTypes{};
 		Conditions::Conditional _conditions{};
 		uint64_t _priority{ 0 };
@@ -45,22 +79,3 @@ namespace DDR
 		bool _cut{ true };
 	};
 }
-
-namespace YAML
-{
-	template <>
-	struct convert<DDR::Response>
-	{
-		static bool decode(const Node& node, DDR::Response& rhs)
-		{
-			if (node["subtitle"].IsDefined()) {
-				rhs.subtitle = node["subtitle"].as<std::string>("");
-			} else {
-				rhs.subtitle = node["sub"].as<std::string>("");
-			}
-			rhs.filePath = node["path"].as<std::string>("");
-			rhs.keep = node["keep"].as<std::string>("") == "true" || node["keep"].as<bool>(false);
-			return true;
-		}
-	};
-}
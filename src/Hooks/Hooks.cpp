@@ -1,5 +1,8 @@
 #include "Hooks.h"
 
+#include "Settings.h"
+#include "Stats.h"
+
 namespace RE
 {
 	int64_t AddTopic(RE::MenuTopicManager* a_this, RE::TESTopic* a_topic, int64_t a_3, int64_t a_4)
@@ -41,12 +44,29 @@ namespace DDR
 
 	int64_t Hooks::PopulateTopicInfo(int64_t a_1, RE::TESTopic* a_2, RE::TESTopicInfo* a_3, RE::Character* a_speaker, RE::TESTopicInfo::ResponseData* a_5)
 	{
-		_response.responseNumber = a_5->responseNumber;
-		if (_response.responseNumber == 1) {
-			_response.response = DialogueManager::GetSingleton()->FindReplacementResponse(a_speaker, a_3, a_5);
-			_response.speaker = a_speaker;
+		if (a_5->responseNumber == 1) {
+			const auto picked = std::chrono::steady_clock::now();
+			const auto target = DialogueSession::ResolveTarget(a_speaker);
+			if (!_session || !_session->Matches(a_speaker, target)) {
+				_session.emplace(a_speaker, target);
+			}
+			const auto manager = DialogueManager::GetSingleton();
+			auto prepared = manager->TakePreparedResponse(a_speaker, a_3);
+			const TopicInfo* replacement;
+			if (prepared) {
+				replacement = manager->FindReplacementResponse(*_session, *prepared);
+				Stats::Add(Stats::preparedHits);
+			} else {
+				replacement = manager->FindReplacementResponse(*_session, a_3);
+				Stats::Add(Stats::preparedMisses);
+			}
+			_session->BeginResponse(a_3, replacement, std::move(prepared), picked);
 		}
-		if (_response.response && _response.response->ShouldCut(_response.responseNumber)) {
+		if (!_session) {
+			return _PopulateTopicInfo(a_1, a_2, a_3, a_speaker, a_5);
+		}
+		_session->SetResponseNumber(a_5->responseNumber);
+		if (_session->ShouldCut()) {
 			delete a_5->next;
 			a_5->next = nullptr;
 		}
@@ -55,15 +75,19 @@ namespace DDR
 
 	char* Hooks::SetSubtitle(RE::DialogueResponse* a_response, char* a_text, int32_t a_3)
 	{
+		if (!_session) {
+			std::string text{ a_text };
+			DialogueManager::GetSingleton()->ApplyTextReplacements(text, nullptr, ReplacementType::Response);
+			return _SetSubtitle(a_response, text.data(), a_3);
+		}
 		std::string text;
-		if (_response.response && _response.response->HasReplacementSubtitle(_response.responseNumber)) {
-			const auto replace = _response.response->GetSubtitle(_response.responseNumber);
-			logger::info("replacing subtitle {} with {}", a_text, replace);
-			text = replace;
+		if (const auto subtitle = _session->GetSubtitle()) {
+			text = *subtitle;
+			logger::info("replacing subtitle {} with {}", a_text, text);
 		} else {
 			text = a_text;
 		}
-		DialogueManager::GetSingleton()->ApplyTextReplacements(text, _response.speaker, ReplacementType::Response);
+		DialogueManager::GetSingleton()->ApplyTextReplacements(text, *_session, ReplacementType::Response);
 		return _SetSubtitle(a_response, text.data(), a_3);
 	}
 
@@ -72,12 +96,18 @@ namespace DDR
 		if (!_ConstructResponse(a_response, a_filePath, a_voiceType, a_topic, a_topicInfo)) {
 			return false;
 		}
-		if (_response.response && _response.response->HasReplacementVoiceFile(_response.responseNumber)) {
-			std::string filePath{ a_filePath };
-			const auto path = _response.response->GetVoiceFilePath(a_topic, a_topicInfo, a_voiceType, a_response->responseNumber);
-			logger::info("replacing voice file {} with {}", filePath, path);
+		if (!_session) {
+			return true;
+		}
+		if (const auto path = _session->GetVoiceFilePath(a_topic, a_topicInfo, a_voiceType, a_response->responseNumber)) {
+			logger::info("replacing voice file {} with {}", a_filePath, *path);
 			*a_filePath = NULL;
-			strcat_s(a_filePath, 0x104ui64, path.c_str());
+			strcat_s(a_filePath, 0x104ui64, path->c_str());
+		}
+		if (a_response->responseNumber == 1) {
+			const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _session->GetPickTime()).count();
+			Stats::Add(Stats::responseLatencyTotal, static_cast<uint64_t>(latency));
+			Stats::Max(Stats::responseLatencyMax, static_cast<uint64_t>(latency));
 		}
 		return true;
 	}
@@ -131,56 +161,212 @@ namespace DDR
 
 	RE::UI_MESSAGE_RESULTS DialogueMenuEx::ProcessMessageEx(RE::UIMessage& a_message)
 	{
-		static std::map<RE::FormID, std::string> cache{};
-		static RE::FormID _activeRootId{ 0 };
 		const auto menu = RE::MenuTopicManager::GetSingleton();
-		const auto manager = DialogueManager::GetSingleton();
-		const auto rootId = menu->rootTopicInfo ? menu->rootTopicInfo->GetFormID() : 0xFFFFFFFF;
 		switch (*a_message.type) {
 		case RE::UI_MESSAGE_TYPE::kShow:
+			DialogueSession::BeginConversation();
+			_topics.Reset();
+			__fallthrough;
 		case RE::UI_MESSAGE_TYPE::kUpdate:
-			_activeRootId = 0;
+			_topics.Invalidate();
 			__fallthrough;
 		default:
-			if (_activeRootId != rootId) {
-				_activeRootId = rootId;
-				cache.clear();
-			}
 			if (const auto dialogue = menu->dialogueList) {
-#pragma warning(suppress : 4834)
-				for (auto it = dialogue->begin(); it != dialogue->end(); it++) {
-					const auto activeTopic = *it;
-					if (!activeTopic) {
-						continue;
-					}
-					const auto formId = activeTopic->parentTopic->GetFormID();
-					auto where = cache.find(formId);
-					if (where != cache.end()) {
-						activeTopic->topicText = where->second;
-						continue;
-					}
-					const auto speaker = menu->speaker.get().get();
-					auto topics = manager->FindReplacementTopic(formId, 0, speaker, false);
-					std::string text{ activeTopic->topicText.c_str() };
-					for (auto&& topic : topics) {
-						if (!topic->GetText().empty()) {
-							text = topic->GetText();
-							break;
-						}
-					}
-					manager->ApplyTextReplacements(text, speaker, ReplacementType::Topic);
-					activeTopic->topicText = text;
-					cache[formId] = text;
-				}
+				_topics.Update(*dialogue, menu->rootTopicInfo, menu->speaker.get().get());
 			}
 			break;
 		case RE::UI_MESSAGE_TYPE::kForceHide:
 		case RE::UI_MESSAGE_TYPE::kHide:
-			_activeRootId = 0;
-			cache.clear();
+			DialogueSession::BeginConversation();
+			_topics.Reset();
+			DialogueManager::GetSingleton()->CollectGarbage();
 			break;
 		}
 		return _ProcessMessageFn(this, a_message);
 	}
 
+	void DialogueMenuEx::TopicCache::Update(RE::BSSimpleList<Dialogue*>& a_list, RE::TESTopicInfo* a_root, RE::TESObjectREFR* a_speaker)
+	{
+		if (_root != a_root) {
+			_root = a_root;
+			Invalidate();
+		}
+		if (_speaker != a_speaker) {
+			_speaker = a_speaker;
+			_dirty = true;
+		}
+		if (Collect()) {
+			_dirty = true;
+		}
+		if (!_dirty && Unchanged(a_list)) {
+			return;
+		}
+		_dirty = false;
+		_nodes.clear();
+		if (Settings::prepareResponses && a_speaker) {
+			Prepare(a_list, a_speaker);
+		}
+		const auto manager = DialogueManager::GetSingleton();
+		const auto target = DialogueSession::ResolveTarget(a_speaker);
+		if (!_session || !_session->Matches(a_speaker, target)) {
+			_session.emplace(a_speaker, target);
+		}
+		// topics are shown to the player, whom the speaker may not be facing yet
+		_session->GetPlaceholders().Bind(a_speaker, RE::PlayerCharacter::GetSingleton());
+		const auto speakerId = a_speaker ? a_speaker->GetFormID() : 0;
+		std::vector<std::pair<Dialogue*, size_t>> pending{};
+		std::vector<std::string> texts{};
+#pragma warning(suppress : 4834)
+		for (auto it = a_list.begin(); it != a_list.end(); it++) {
+			const auto node = *it;
+			_nodes.push_back(node);
+			if (!node || !node->parentTopic) {
+				continue;
+			}
+			const auto topicId = node->parentTopic->GetFormID();
+			const std::string_view current{ node->topicText.c_str() };
+			auto entry = Find(topicId, speakerId);
+			if (entry && entry->inFlight) {
+				continue;
+			}
+			if (entry && entry->generation == _generation) {
+				if (current != entry->GetReplaced()) {
+					node->topicText = entry->replaced;
+				}
+				continue;
+			}
+			// a node from an earlier generation still shows its replacement, which must not be replaced twice
+			const bool stale = entry != nullptr;
+			if (!entry) {
+				entry = std::addressof(_entries.emplace_back(topicId, speakerId));
+			}
+			if (!stale || current != entry->GetReplaced()) {
+				entry->original = current;
+			}
+			std::string text{ entry->original };
+			for (auto&& topic : manager->FindReplacementTopic(topicId, 0, a_speaker, false)) {
+				if (!topic->GetText().empty()) {
+					text = topic->GetText().Expand(_session->GetPlaceholders());
+					break;
+				}
+			}
+			pending.emplace_back(node, static_cast<size_t>(entry - _entries.data()));
+			texts.push_back(std::move(text));
+		}
+		if (pending.empty()) {
+			return;
+		}
+		// all new topics go through the scripts in a single batch. If a worker takes longer than the wait,
+		// the original texts stay up and the results are shown by the UI task queued on completion
+		auto& batch = _batches.emplace_back(
+			manager->ApplyTextReplacementsAsync(std::move(texts), *_session, ReplacementType::Topic, [] {
+				SKSE::GetTaskInterface()->AddUITask([] { _topics.Refresh(); });
+			}),
+			std::vector<size_t>{}, _generation);
+		for (const auto& [node, index] : pending) {
+			_entries[index].inFlight = true;
+			batch.entries.push_back(index);
+		}
+		if (batch.result.wait_for(std::chrono::duration<float, std::milli>(Settings::workerWait)) != std::future_status::ready || !Collect()) {
+			return;
+		}
+		for (const auto& [node, index] : pending) {
+			const auto& entry = _entries[index];
+			// most topics come back unchanged and keep the text the engine already built
+			if (entry.generation == _generation && std::string_view{ node->topicText.c_str() } != entry.GetReplaced()) {
+				node->topicText = entry.replaced;
+			}
+		}
+	}
+
+	void DialogueMenuEx::TopicCache::Prepare(RE::BSSimpleList<Dialogue*>& a_list, RE::TESObjectREFR* a_speaker)
+	{
+		std::vector<RE::TESTopicInfo*> topicInfos{};
+#pragma warning(suppress : 4834)
+		for (auto it = a_list.begin(); it != a_list.end(); it++) {
+			if (const auto node = *it; node && node->parentTopicInfo) {
+				topicInfos.push_back(node->parentTopicInfo);
+			}
+		}
+		if (topicInfos.empty()) {
+			return;
+		}
+		// resolved in the next frame rather than while the menu processes its message, the player is still reading the list by then
+		SKSE::GetTaskInterface()->AddTask([handle = a_speaker->GetHandle(), topicInfos = std::move(topicInfos)] {
+			const auto ref = handle.get();
+			if (const auto speaker = ref ? ref->As<RE::Character>() : nullptr) {
+				DialogueManager::GetSingleton()->PrepareResponses(speaker, topicInfos);
+			}
+		});
+	}
+
+	bool DialogueMenuEx::TopicCache::Collect()
+	{
+		bool any = false;
+		std::erase_if(_batches, [&](Batch& a_batch) {
+			if (a_batch.result.wait_for(std::chrono::seconds::zero()) != std::future_status::ready) {
+				return false;
+			}
+			auto texts = a_batch.result.get();
+			for (size_t i = 0; i < a_batch.entries.size(); i++) {
+				auto& entry = _entries[a_batch.entries[i]];
+				entry.replaced = texts[i];
+				entry.generation = a_batch.generation;
+				entry.inFlight = false;
+			}
+			any = true;
+			return true;
+		});
+		return any;
+	}
+
+	void DialogueMenuEx::TopicCache::Refresh()
+	{
+		const auto ui = RE::UI::GetSingleton();
+		const auto menu = RE::MenuTopicManager::GetSingleton();
+		if (!ui || !ui->IsMenuOpen(RE::DialogueMenu::MENU_NAME) || !menu->dialogueList) {
+			return;
+		}
+		Update(*menu->dialogueList, menu->rootTopicInfo, menu->speaker.get().get());
+	}
+
+	bool DialogueMenuEx::TopicCache::Unchanged(RE::BSSimpleList<Dialogue*>& a_list) const
+	{
+		size_t i = 0;
+#pragma warning(suppress : 4834)
+		for (auto it = a_list.begin(); it != a_list.end(); it++, i++) {
+			if (i >= _nodes.size() || _nodes[i] != *it) {
+				return false;
+			}
+		}
+		return i == _nodes.size();
+	}
+
+	DialogueMenuEx::TopicCache::Entry* DialogueMenuEx::TopicCache::Find(RE::FormID a_topic, RE::FormID a_speaker)
+	{
+		const auto where = std::ranges::find_if(_entries, [&](const Entry& a_entry) {
+			return a_entry.topic == a_topic && a_entry.speaker == a_speaker;
+		});
+		return where != _entries.end() ? std::addressof(*where) : nullptr;
+	}
+
+	void DialogueMenuEx::TopicCache::Invalidate()
+	{
+		_generation++;
+		_dirty = true;
+		DialogueManager::GetSingleton()->InvalidatePreparedResponses();
+	}
+
+	void DialogueMenuEx::TopicCache::Reset()
+	{
+		_entries.clear();
+		_batches.clear();
+		_nodes.clear();
+		_root = nullptr;
+		_speaker = nullptr;
+		_session.reset();
+		_dirty = true;
+		DialogueManager::GetSingleton()->InvalidatePreparedResponses();
+	}
+
 }	 // namespace DDR
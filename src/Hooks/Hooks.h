@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Dialogue/DialogueManager.h"
+#include "Dialogue/DialogueSession.h"
 #include <unordered_set>
 
 namespace RE
@@ -18,13 +19,6 @@ namespace DDR
 		static void Install();
 
 	private:
-		struct Response
-		{
-			RE::Character* speaker{ nullptr };
-			std::shared_ptr<TopicInfo> response{ nullptr };
-			int32_t responseNumber{ -1 };
-		};
-
 		static int64_t PopulateTopicInfo(int64_t a_1, RE::TESTopic* a_2, RE::TESTopicInfo* a_3, RE::Character* a_4, RE::TESTopicInfo::ResponseData* a_5);
 		static inline PopulateTopicInfoType _PopulateTopicInfo;
 
@@ -34,7 +28,8 @@ namespace DDR
 		static bool ConstructResponse(RE::TESTopicInfo::ResponseData* a_response, char* a_filePath, RE::BGSVoiceType* a_voiceType, RE::TESTopic* a_topic, RE::TESTopicInfo* a_topicInfo);
 		static inline REL::Relocation<decltype(ConstructResponse)> _ConstructResponse;
 
-		thread_local static inline Response _response{};
+		/// @brief Conversation of the response being populated on this thread, replaced when speaker, target or conversation change
+		thread_local static inline std::optional<DialogueSession> _session{};
 
 	private:
 		static inline int64_t AddTopic(RE::MenuTopicManager* a_this, RE::TESTopic* a_topic, RE::TESTopic* a_activeTopic, uint64_t a_4);
@@ -53,7 +48,62 @@ namespace DDR
 		RE::UI_MESSAGE_RESULTS ProcessMessageEx(RE::UIMessage& a_message);
 
 	private:
+		/// @brief Replaced topic texts of the open menu. The dialogue list is only revisited when its fingerprint changes
+		class TopicCache
+		{
+			using Dialogue = RE::MenuTopicManager::Dialogue;
+			using TopicText = decltype(Dialogue::topicText);
+
+			struct Entry
+			{
+				RE::FormID topic;
+				RE::FormID speaker;
+				std::string original{};
+				TopicText replaced{};	 // kept in the engine's own type, so showing it again is a plain copy
+				uint32_t generation{ 0 };
+				bool inFlight{ false };	 // replacement is being computed by a worker
+
+				_NODISCARD std::string_view GetReplaced() const { return replaced.c_str(); }
+			};
+
+			/// @brief Topic texts handed to a worker, committed to their entries on the menu's thread
+			struct Batch
+			{
+				LuaWorkerPool::Result result;
+				std::vector<size_t> entries;
+				uint32_t generation;
+			};
+
+		public:
+			/// @brief Apply replacements to every topic which appeared since the last call
+			void Update(RE::BSSimpleList<Dialogue*>& a_list, RE::TESTopicInfo* a_root, RE::TESObjectREFR* a_speaker);
+			/// @brief Re-evaluate all topics on the next update. Texts already shown are replaced from their original
+			void Invalidate();
+			/// @brief Forget the session
+			void Reset();
+			/// @brief Show results which became available since the last update. Queued as a UI task by workers
+			void Refresh();
+
+		private:
+			_NODISCARD bool Unchanged(RE::BSSimpleList<Dialogue*>& a_list) const;
+			Entry* Find(RE::FormID a_topic, RE::FormID a_speaker);
+			/// @brief Queue the topic infos the visible topics would answer with, to be resolved before the player picks one
+			void Prepare(RE::BSSimpleList<Dialogue*>& a_list, RE::TESObjectREFR* a_speaker);
+			/// @brief Commit every finished batch. @return true if any entry changed
+			bool Collect();
+
+			std::vector<Entry> _entries{};
+			std::vector<Batch> _batches{};
+			std::vector<Dialogue*> _nodes{};	 // dialogue list as last processed
+			RE::TESTopicInfo* _root{ nullptr };
+			RE::TESObjectREFR* _speaker{ nullptr };
+			std::optional<DialogueSession> _session{};	// speaker of the open menu and its dialogue target
+			uint32_t _generation{ 0 };
+			bool _dirty{ true };
+		};
+
 		using ProcessMessageFn = decltype(&RE::DialogueMenu::ProcessMessage);
 		static inline REL::Relocation<ProcessMessageFn> _ProcessMessageFn;
+		static inline TopicCache _topics{};
 	};
 }
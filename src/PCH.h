@@ -10,6 +10,7 @@
 #pragma warning(pop)
 
 #include <atomic>
+#include <future>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Dialogue/DialogueManager.h"
+#include "Stats.h"
 
 using namespace DDR;
 
@@ -10,6 +11,9 @@ namespace
 
 	std::string AddReplacementTopic(RE::StaticFunctionTag*, RE::FormID a_topicId, std::string a_text) { return DialogueManager::GetSingleton()->AddReplacementTopic(a_topicId, a_text); }
 	void RemoveReplacementTopic(RE::StaticFunctionTag*, RE::FormID a_topicId, std::string a_key) { return DialogueManager::GetSingleton()->RemoveReplacementTopic(a_topicId, a_key); }
+	std::vector<int32_t> AddReplacementTopics(RE::StaticFunctionTag*, std::vector<RE::FormID> a_topicIds, std::vector<std::string> a_texts) { return DialogueManager::GetSingleton()->AddReplacementTopics(a_topicIds, a_texts); }
+	void RemoveReplacementTopics(RE::StaticFunctionTag*, std::vector<RE::FormID> a_topicIds, std::vector<int32_t> a_handles) { return DialogueManager::GetSingleton()->RemoveReplacementTopics(a_topicIds, a_handles); }
+	std::string GetStatistics(RE::StaticFunctionTag*) { return Stats::Format(); }
 }
 
 namespace DDR::Papyrus
@@ -20,6 +24,9 @@ namespace DDR::Papyrus
 		
 		REGISTERPAPYRUSFUNC(AddReplacementTopic)
 		REGISTERPAPYRUSFUNC(RemoveReplacementTopic)
+		REGISTERPAPYRUSFUNC(AddReplacementTopics)
+		REGISTERPAPYRUSFUNC(RemoveReplacementTopics)
+		REGISTERPAPYRUSFUNC(GetStatistics)
 
 		return true;
 	}
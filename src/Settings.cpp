@@ -0,0 +1,41 @@
+#include "Settings.h"
+
+#include "Util/Random.h"
+
+namespace DDR
+{
+	void Settings::Load()
+	{
+		std::error_code ec{};
+		if (!fs::exists(SETTINGS_PATH, ec)) {
+			logger::info("No settings file found at {}, using defaults", SETTINGS_PATH);
+			return;
+		}
+		try {
+			const auto file = YAML::LoadFile(std::string{ SETTINGS_PATH });
+			randomSeed = file["seed"].as<uint64_t>(randomSeed);
+			preload = file["preload"].as<bool>(preload);
+			streamingLoader = file["streamingLoader"].as<bool>(streamingLoader);
+			backgroundCompile = file["backgroundCompile"].as<bool>(backgroundCompile);
+			loadReportSize = file["loadReportSize"].as<uint32_t>(loadReportSize);
+			prepareResponses = file["prepareResponses"].as<bool>(prepareResponses);
+			if (randomSeed != 0) {
+				Random::seed(randomSeed);
+				logger::info("Using fixed random seed {}", randomSeed);
+			}
+			if (const auto lua = file["lua"]; lua.IsDefined()) {
+				scriptInstructionBudget = lua["instructionBudget"].as<uint32_t>(scriptInstructionBudget);
+				scriptTimeBudget = lua["timeBudget"].as<float>(scriptTimeBudget);
+				scriptQuarantineThreshold = lua["quarantine"].as<uint32_t>(scriptQuarantineThreshold);
+				gcStepTime = lua["gcStepTime"].as<float>(gcStepTime);
+				gcIdleThreshold = lua["gcIdleThreshold"].as<uint32_t>(gcIdleThreshold);
+				gcFullThreshold = lua["gcFullThreshold"].as<uint32_t>(gcFullThreshold);
+				luaWorkers = lua["workers"].as<uint32_t>(luaWorkers);
+				workerWait = lua["workerWait"].as<float>(workerWait);
+			}
+			logger::info("Loaded settings from {}", SETTINGS_PATH);
+		} catch (const std::exception& e) {
+			logger::error("Failed to load settings from {} - {}. Using defaults", SETTINGS_PATH, e.what());
+		}
+	}
+}	 // namespace DDR
@@ -0,0 +1,33 @@
+#pragma once
+
+namespace DDR
+{
+	constexpr static std::string_view SETTINGS_PATH = "Data\\SKSE\\Plugins\\DynamicDialogueReplacer.yaml";
+
+	struct Settings
+	{
+		Settings() = delete;
+
+		static void Load();
+
+		// General
+		static inline uint64_t randomSeed{ 0 };												// fixed seed to replay random choices, 0 = random
+		static inline bool preload{ true };														// read replacement files and compile scripts on a worker thread while the game starts
+		static inline bool streamingLoader{ true };										// stream replacement files instead of loading them as documents
+		static inline bool backgroundCompile{ false };								// compile all conditions on a worker thread after loading, instead of on first use
+		static inline uint32_t loadReportSize{ 5 };										// slowest files listed in the log after loading, the full report is written as JSON
+		static inline bool prepareResponses{ true };									// resolve the response replacements of visible topics in idle frames, before one is picked
+
+		// Lua
+		// Budgets are opt-in: the count hook that enforces them never fires inside compiled traces,
+		// so a script with either budget set runs in the interpreter instead of the JIT
+		static inline uint32_t scriptInstructionBudget{ 0 };					// instructions per replace() call, 0 = unlimited
+		static inline float scriptTimeBudget{ 0.0f };									// milliseconds per replace() call, 0 = unlimited
+		static inline uint32_t scriptQuarantineThreshold{ 3 };				// budget overruns after which a script is disabled, 0 = never
+		static inline float gcStepTime{ 0.5f };												// milliseconds of incremental collection per step
+		static inline uint32_t gcIdleThreshold{ 256 };								// KB of heap growth before an idle step is scheduled
+		static inline uint32_t gcFullThreshold{ 32768 };							// KB of heap above which a full collection runs instead
+		static inline uint32_t luaWorkers{ 1 };												// worker threads for scripts marked pure, 0 = run everything inline
+		static inline float workerWait{ 4.0f };												// milliseconds a subtitle waits for its worker before the original text is used
+	};
+}	 // namespace DDR
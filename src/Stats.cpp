@@ -0,0 +1,28 @@
+#include "Stats.h"
+
+namespace DDR
+{
+	std::string Stats::Format()
+	{
+		const auto picked = preparedHits.load() + preparedMisses.load();
+		const auto collections = gcSteps.load() + gcFullCollections.load();
+		const auto workerCollections = workerGcSteps.load() + workerGcFullCollections.load();
+		return std::format(
+			"Filter: {} rejected, {} passed, {} false positives\n"
+			"Responses: {} prepared, {} hits, {} misses, latency avg {}us, max {}us\n"
+			"Sessions: {} created, {} responses reused, {} cache hits, {} misses\n"
+			"Conditions compiled: {}\n"
+			"Lua heap: {} KB\n"
+			"GC: {} incremental, {} full, pause avg {}us, max {}us\n"
+			"Workers: {} jobs, {} timeouts\n"
+			"Worker GC: {} incremental, {} full, pause avg {}us, max {}us",
+			filterRejected.load(), filterPassed.load(), filterFalsePositives.load(),
+			responsesPrepared.load(), preparedHits.load(), preparedMisses.load(), picked ? responseLatencyTotal.load() / picked : 0, responseLatencyMax.load(),
+			sessionsCreated.load(), sessionResponsesReused.load(), sessionCacheHits.load(), sessionCacheMisses.load(),
+			conditionsCompiled.load(),
+			luaHeapSize.load() / 1024,
+			gcSteps.load(), gcFullCollections.load(), collections ? gcPauseTotal.load() / collections : 0, gcPauseMax.load(),
+			workerJobs.load(), workerTimeouts.load(),
+			workerGcSteps.load(), workerGcFullCollections.load(), workerCollections ? workerGcPauseTotal.load() / workerCollections : 0, workerGcPauseMax.load());
+	}
+}	 // namespace DDR
@@ -0,0 +1,56 @@
+#pragma once
+
+namespace DDR
+{
+	/// @brief Runtime counters, exposed to Papyrus through GetStatistics
+	struct Stats
+	{
+		Stats() = delete;
+
+		/// @brief Human readable dump of all counters
+		static std::string Format();
+
+		/// @brief Counters are statistics only, relaxed increments keep the hooks free of full fences
+		static void Add(std::atomic<uint64_t>& a_stat, uint64_t a_value = 1) { a_stat.fetch_add(a_value, std::memory_order_relaxed); }
+
+		static void Max(std::atomic<uint64_t>& a_stat, uint64_t a_value)
+		{
+			auto current = a_stat.load(std::memory_order_relaxed);
+			while (current < a_value && !a_stat.compare_exchange_weak(current, a_value, std::memory_order_relaxed)) {}
+		}
+
+		// Replacement lookups
+		static inline std::atomic<uint64_t> filterRejected{ 0 };				 // lookups answered by the filter alone
+		static inline std::atomic<uint64_t> filterPassed{ 0 };
+		static inline std::atomic<uint64_t> filterFalsePositives{ 0 };	 // passed response lookups without any candidates
+
+		// Responses
+		static inline std::atomic<uint64_t> responsesPrepared{ 0 };		 // topic infos resolved speculatively while the player browses
+		static inline std::atomic<uint64_t> preparedHits{ 0 };				 // picked topics served from a prepared result
+		static inline std::atomic<uint64_t> preparedMisses{ 0 };			 // picked topics resolved on demand
+		static inline std::atomic<uint64_t> responseLatencyTotal{ 0 };	 // microseconds from the picked response being populated to its voice file being resolved
+		static inline std::atomic<uint64_t> responseLatencyMax{ 0 };		 // microseconds
+
+		// Sessions
+		static inline std::atomic<uint64_t> sessionsCreated{ 0 };
+		static inline std::atomic<uint64_t> sessionResponsesReused{ 0 };	 // responses which kept the expanded texts of the previous one
+		static inline std::atomic<uint64_t> sessionCacheHits{ 0 };				 // subtitles and voice files served already expanded
+		static inline std::atomic<uint64_t> sessionCacheMisses{ 0 };
+
+		// Conditions
+		static inline std::atomic<uint64_t> conditionsCompiled{ 0 };		 // condition lists parsed on demand
+
+		// Lua
+		static inline std::atomic<uint64_t> luaHeapSize{ 0 };			 // bytes
+		static inline std::atomic<uint64_t> gcSteps{ 0 };
+		static inline std::atomic<uint64_t> gcFullCollections{ 0 };
+		static inline std::atomic<uint64_t> gcPauseTotal{ 0 };		 // microseconds
+		static inline std::atomic<uint64_t> gcPauseMax{ 0 };			 // microseconds
+		static inline std::atomic<uint64_t> workerJobs{ 0 };			 // texts handed to pure script workers
+		static inline std::atomic<uint64_t> workerTimeouts{ 0 };	 // subtitles which gave up waiting for their worker
+		static inline std::atomic<uint64_t> workerGcSteps{ 0 };
+		static inline std::atomic<uint64_t> workerGcFullCollections{ 0 };
+		static inline std::atomic<uint64_t> workerGcPauseTotal{ 0 };	 // microseconds
+		static inline std::atomic<uint64_t> workerGcPauseMax{ 0 };		 // microseconds
+	};
+}	 // namespace DDR
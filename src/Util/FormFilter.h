@@ -0,0 +1,92 @@
+#pragma once
+
+#include <bit>
+
+namespace Util
+{
+	/// @brief Blocked Bloom filter over form ids. Every probe touches a single cache line
+	/// May report ids which were never added, but never misses one that was
+	class FormFilter
+	{
+		static constexpr size_t WORDS = 8;
+		static constexpr size_t BITS_PER_KEY = 16;
+		static constexpr size_t MAX_BLOCKS = 1 << 16;
+
+		struct alignas(64) Block
+		{
+			std::array<std::uint64_t, WORDS> words{};
+		};
+
+	public:
+		void Build(std::span<const RE::FormID> a_ids)
+		{
+			const auto numBlocks = std::clamp<size_t>((a_ids.size() * BITS_PER_KEY + WORDS * 64 - 1) / (WORDS * 64), 1, MAX_BLOCKS);
+			_blocks.assign(numBlocks, Block{});
+			for (const auto id : a_ids) {
+				const auto hash = Hash(id);
+				auto& block = _blocks[BlockIndex(hash)];
+				for (size_t i = 0; i < WORDS; i++) {
+					block.words[i] |= Bit(hash, i);
+				}
+			}
+		}
+
+		_NODISCARD bool MayContain(RE::FormID a_id) const
+		{
+			if (_blocks.empty()) {
+				return false;
+			}
+			const auto hash = Hash(a_id);
+			const auto& block = _blocks[BlockIndex(hash)];
+			for (size_t i = 0; i < WORDS; i++) {
+				if ((block.words[i] & Bit(hash, i)) == 0) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/// @brief Probability of a false positive for an id not in the filter, derived from the actual fill of each block
+		_NODISCARD double FalsePositiveRate() const
+		{
+			if (_blocks.empty()) {
+				return 0.0;
+			}
+			double sum = 0.0;
+			for (const auto& block : _blocks) {
+				double p = 1.0;
+				for (const auto word : block.words) {
+					p *= static_cast<double>(std::popcount(word)) / 64.0;
+				}
+				sum += p;
+			}
+			return sum / static_cast<double>(_blocks.size());
+		}
+
+		_NODISCARD size_t GetMemoryUsage() const { return _blocks.size() * sizeof(Block); }
+
+	private:
+		static std::uint64_t Hash(RE::FormID a_id)
+		{
+			// splitmix64 finalizer, form ids of one plugin only differ in the low bits
+			std::uint64_t z = a_id + 0x9E3779B97F4A7C15;
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+			return z ^ (z >> 31);
+		}
+
+		/// @brief Selected by the top 16 bits, which the bit slices leave unused. Caps the filter at 65536 blocks (4 MB)
+		size_t BlockIndex(std::uint64_t a_hash) const
+		{
+			return static_cast<size_t>(((a_hash >> 48) * _blocks.size()) >> 16);
+		}
+
+		/// @brief One bit per word, selected by consecutive 6 bit slices of the low 48 bits of the hash
+		static std::uint64_t Bit(std::uint64_t a_hash, size_t a_word)
+		{
+			return std::uint64_t{ 1 } << ((a_hash >> (a_word * 6)) & 63);
+		}
+
+		std::vector<Block> _blocks{};
+	};
+}	 // namespace Util
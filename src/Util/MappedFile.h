@@ -0,0 +1,62 @@
+#pragma once
+
+namespace Util
+{
+	/// @brief Read-only memory mapping of an entire file
+	class MappedFile
+	{
+	public:
+		explicit MappedFile(const fs::path& a_path)
+		{
+			_file = ::CreateFileW(a_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (_file == INVALID_HANDLE_VALUE) {
+				throw std::runtime_error(std::format("Failed to open {} ({})", a_path.string(), ::GetLastError()));
+			}
+			LARGE_INTEGER size{};
+			if (!::GetFileSizeEx(_file, std::addressof(size))) {
+				Close();
+				throw std::runtime_error(std::format("Failed to read size of {} ({})", a_path.string(), ::GetLastError()));
+			}
+			_size = static_cast<size_t>(size.QuadPart);
+			if (_size == 0) {
+				return;	 // empty files cannot be mapped
+			}
+			_mapping = ::CreateFileMappingW(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			_view = _mapping ? static_cast<const char*>(::MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+			if (!_view) {
+				const auto error = ::GetLastError();
+				Close();
+				throw std::runtime_error(std::format("Failed to map {} ({})", a_path.string(), error));
+			}
+		}
+		~MappedFile() { Close(); }
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		_NODISCARD std::span<const char> data() const { return { _view, _view ? _size : 0 }; }
+		_NODISCARD size_t size() const { return _size; }
+
+	private:
+		void Close()
+		{
+			if (_view) {
+				::UnmapViewOfFile(_view);
+				_view = nullptr;
+			}
+			if (_mapping) {
+				::CloseHandle(_mapping);
+				_mapping = nullptr;
+			}
+			if (_file != INVALID_HANDLE_VALUE) {
+				::CloseHandle(_file);
+				_file = INVALID_HANDLE_VALUE;
+			}
+		}
+
+		HANDLE _file{ INVALID_HANDLE_VALUE };
+		HANDLE _mapping{ nullptr };
+		const char* _view{ nullptr };
+		size_t _size{ 0 };
+	};
+}	 // namespace Util
@@ -2,39 +2,118 @@
 
 #include <random>
 
+/// @brief xoshiro256**, a small-state generator satisfying UniformRandomBitGenerator
+class Xoshiro256
+{
+public:
+	using result_type = std::uint64_t;
+
+	explicit Xoshiro256(std::uint64_t a_seed)
+	{
+		// expand the seed with splitmix64, as recommended by the authors
+		for (auto& s : _state) {
+			a_seed += 0x9E3779B97F4A7C15;
+			auto z = a_seed;
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+			s = z ^ (z >> 31);
+		}
+	}
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	result_type operator()()
+	{
+		const auto result = std::rotl(_state[1] * 5, 7) * 9;
+		const auto t = _state[1] << 17;
+		_state[2] ^= _state[0];
+		_state[3] ^= _state[1];
+		_state[1] ^= _state[2];
+		_state[0] ^= _state[3];
+		_state[2] ^= t;
+		_state[3] = std::rotl(_state[3], 45);
+		return result;
+	}
+
+private:
+	std::array<std::uint64_t, 4> _state;
+};
+
 struct Random
 {
 	Random() = delete;
 
-	static inline std::mt19937 eng{ std::random_device{}() };
+	/// @brief Stable role of a thread, which selects its stream of a seeded run
+	enum class Stream : std::uint64_t
+	{
+		kMain = 0,		 // the game's main thread, which runs the dialogue hooks
+		kWorker = 16,	 // + index of the Lua worker
+		kUnbound = 1ull << 32,	// + order of the first draw, not reproducible if several unbound threads draw
+	};
+
+	/// @brief Seed all generators deterministically. Threads derive their stream from the seed and their bound role. 0 restores non-deterministic seeding
+	/// Only affects threads which have not drawn yet, so this should be called before any dialogue is processed
+	static inline void seed(std::uint64_t a_seed)
+	{
+		_seed = a_seed;
+		_unbound = 0;
+	}
+
+	/// @brief Bind the calling thread to a stable role, so its draws do not depend on the order in which threads are scheduled
+	/// Must be called when the thread is created, before its first draw
+	static inline void bind(Stream a_stream, std::uint64_t a_index = 0)
+	{
+		_stream = static_cast<std::uint64_t>(a_stream) + a_index;
+	}
+
+	/// @brief The generator of the calling thread
+	static inline Xoshiro256& engine()
+	{
+		thread_local Xoshiro256 eng{ [] {
+			const auto stream = _stream ? *_stream : static_cast<std::uint64_t>(Stream::kUnbound) + _unbound++;
+			if (const auto seed = _seed.load(); seed != 0) {
+				return seed + stream * 0xD1B54A32D192ED03;
+			}
+			std::random_device rd{};
+			return (static_cast<std::uint64_t>(rd()) << 32) | rd();
+		}() };
+		return eng;
+	}
 
 	template <class T>
 	static inline T draw(T a_min, T a_max)
 	{
 		if constexpr (std::is_integral_v<T>)
-			return std::uniform_int_distribution<T>{ a_min, a_max }(eng);
+			return std::uniform_int_distribution<T>{ a_min, a_max }(engine());
 		else
-			return std::uniform_real_distribution<T>{ a_min, a_max }(eng);
+			return std::uniform_real_distribution<T>{ a_min, a_max }(engine());
 	}
 
 	template <class V>
 	static inline void shuffle(V& a_container)
 	{
-		std::ranges::shuffle(a_container, eng);
+		std::ranges::shuffle(a_container, engine());
 	}
 
 	static inline std::string generateUUID()
 	{
 		constexpr std::string_view v = "0123456789abcdef";
 		constexpr std::string_view templateStr{ "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx" };
-		std::uniform_int_distribution<size_t> dist{ 0, v.size() };
+		std::uniform_int_distribution<size_t> dist{ 0, v.size() - 1 };
 
 		std::string ret{ templateStr };
-		for (int i = 0; i < ret.size(); i++) {
-			if (ret[i] == 'x') {
-				ret[i] = v[dist(eng)];
+		auto& eng = engine();
+		for (auto& c : ret) {
+			if (c == 'x') {
+				c = v[dist(eng)];
 			}
 		}
 		return ret;
 	}
+
+private:
+	static inline std::atomic<std::uint64_t> _seed{ 0 };
+	static inline std::atomic<std::uint64_t> _unbound{ 0 };
+	thread_local static inline std::optional<std::uint64_t> _stream{};
 };
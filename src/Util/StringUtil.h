@@ -30,6 +30,46 @@ namespace Util
 #undef STR_TRANSFORM
 #pragma warning(pop)
 
+	constexpr char AsciiToUpper(char a_char)
+	{
+		return a_char >= 'a' && a_char <= 'z' ? static_cast<char>(a_char - ('a' - 'A')) : a_char;
+	}
+
+	/// @brief Case insensitive FNV-1a over ASCII. Doubles as a seeded hasher for frozen tables
+	struct CaseInsensitiveHash
+	{
+		using is_transparent = void;
+
+		template <class S>
+		constexpr std::size_t operator()(const S& a_str, std::size_t a_seed = 0) const
+		{
+			std::size_t hash = (0x811c9dc5 ^ a_seed) * static_cast<std::size_t>(0x01000193);
+			for (const char c : a_str) {
+				hash = (hash ^ static_cast<std::size_t>(static_cast<unsigned char>(AsciiToUpper(c)))) * static_cast<std::size_t>(0x01000193);
+			}
+			return hash >> 8;
+		}
+	};
+
+	struct CaseInsensitiveEqual
+	{
+		using is_transparent = void;
+
+		template <class L, class R>
+		constexpr bool operator()(const L& a_lhs, const R& a_rhs) const
+		{
+			if (a_lhs.size() != a_rhs.size()) {
+				return false;
+			}
+			for (std::size_t i = 0; i < a_lhs.size(); i++) {
+				if (AsciiToUpper(a_lhs[i]) != AsciiToUpper(a_rhs[i])) {
+					return false;
+				}
+			}
+			return true;
+		}
+	};
+
 	inline std::vector<std::string_view> StringSplit(const std::string_view& a_view, const std::string_view& a_delim)
 	{
 		namespace views = std::ranges::views;
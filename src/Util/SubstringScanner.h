@@ -0,0 +1,121 @@
+#pragma once
+
+#include <bit>
+#include <immintrin.h>
+#include <intrin.h>
+
+namespace Util
+{
+	/// @brief Tests a text for any of a fixed set of substrings (case sensitive)
+	/// Candidate positions are found by comparing the first and last byte of a needle against 32 (AVX2) or 16 (SSE2) positions at once
+	class SubstringScanner
+	{
+		using FindFn = bool (*)(std::string_view a_text, std::string_view a_needle);
+
+	public:
+		SubstringScanner() = default;
+		explicit SubstringScanner(std::vector<std::string> a_needles) :
+			_needles(std::move(a_needles)),
+			_find(HasAVX2() ? &FindAVX2 : &FindSSE2)
+		{
+			std::erase_if(_needles, [](const auto& needle) { return needle.empty(); });
+		}
+
+		_NODISCARD bool empty() const { return _needles.empty(); }
+
+		/// @brief If a_text contains any of the needles. An empty scanner matches every text
+		_NODISCARD bool Matches(std::string_view a_text) const
+		{
+			if (_needles.empty()) {
+				return true;
+			}
+			for (const auto& needle : _needles) {
+				if (_find(a_text, needle)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+	private:
+		static bool HasAVX2()
+		{
+			static const bool supported = [] {
+				std::array<int, 4> info{};
+				__cpuid(info.data(), 0);
+				if (info[0] < 7) {
+					return false;
+				}
+				__cpuid(info.data(), 1);
+				const bool osxsave = (info[2] & (1 << 27)) != 0;
+				const bool avx = (info[2] & (1 << 28)) != 0;
+				if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+					return false;
+				}
+				__cpuidex(info.data(), 7, 0);
+				return (info[1] & (1 << 5)) != 0;
+			}();
+			return supported;
+		}
+
+		static bool FindScalar(std::string_view a_text, std::string_view a_needle)
+		{
+			return a_text.find(a_needle) != std::string_view::npos;
+		}
+
+		static bool FindSSE2(std::string_view a_text, std::string_view a_needle)
+		{
+			constexpr size_t WIDTH = 16;
+			const auto n = a_needle.size();
+			if (a_text.size() < n) {
+				return false;
+			}
+			const auto first = _mm_set1_epi8(a_needle.front());
+			const auto last = _mm_set1_epi8(a_needle.back());
+			const auto data = a_text.data();
+			size_t i = 0;
+			for (; i + n - 1 + WIDTH <= a_text.size(); i += WIDTH) {
+				const auto blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+				const auto blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + n - 1));
+				auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast))));
+				while (mask != 0) {
+					if (std::memcmp(data + i + std::countr_zero(mask), a_needle.data(), n) == 0) {
+						return true;
+					}
+					mask &= mask - 1;
+				}
+			}
+			return FindScalar(a_text.substr(i), a_needle);
+		}
+
+		static bool FindAVX2(std::string_view a_text, std::string_view a_needle)
+		{
+			constexpr size_t WIDTH = 32;
+			const auto n = a_needle.size();
+			if (a_text.size() < n) {
+				return false;
+			}
+			const auto first = _mm256_set1_epi8(a_needle.front());
+			const auto last = _mm256_set1_epi8(a_needle.back());
+			const auto data = a_text.data();
+			size_t i = 0;
+			for (; i + n - 1 + WIDTH <= a_text.size(); i += WIDTH) {
+				const auto blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+				const auto blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + n - 1));
+				auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast))));
+				while (mask != 0) {
+					if (std::memcmp(data + i + std::countr_zero(mask), a_needle.data(), n) == 0) {
+						return true;
+					}
+					mask &= mask - 1;
+				}
+			}
+			// the remainder is shorter than a single AVX2 block, but may still fill an SSE2 one
+			return FindSSE2(a_text.substr(i), a_needle);
+		}
+
+	private:
+		std::vector<std::string> _needles{};
+		FindFn _find{ &FindScalar };
+	};
+}	 // namespace Util
@@ -0,0 +1,28 @@
+#pragma once
+
+namespace Util
+{
+	/// @brief Decode a plain scalar with yaml-cpp's own conversion rules (e.g. true/yes/on for bools)
+	/// @return false if the value does not convert, a_out is left untouched in that case
+	template <class T>
+	bool DecodeScalar(const std::string& a_value, T& a_out)
+	{
+		T value{};
+		if (!YAML::convert<T>::decode(YAML::Node{ a_value }, value)) {
+			return false;
+		}
+		a_out = std::move(value);
+		return true;
+	}
+
+	template <class T>
+	bool DecodeScalar(const std::string& a_value, std::optional<T>& a_out)
+	{
+		T value{};
+		if (!DecodeScalar(a_value, value)) {
+			return false;
+		}
+		a_out = std::move(value);
+		return true;
+	}
+}	 // namespace Util
@@ -1,11 +1,21 @@
+#include "API/NativeAPI.h"
 #include "Dialogue/DialogueManager.h"
 #include "Hooks/Hooks.h"
 #include "Papyrus.h"
+#include "Settings.h"
+#include "Util/Random.h"
 
 void SKSEMessageHandler(SKSE::MessagingInterface::Message* message) noexcept
 {
-	if (message->type == SKSE::MessagingInterface::kDataLoaded) {
+	switch (message->type) {
+	case SKSE::MessagingInterface::kPostLoad:
+		DialogueManager::GetSingleton()->StartPreload();
+		break;
+	case SKSE::MessagingInterface::kDataLoaded:
 		DialogueManager::GetSingleton()->Init();
+		break;
+	default:
+		break;
 	}
 }
 
@@ -50,12 +60,18 @@ extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Load(const SKSE::LoadInterface* a_s
 	}
 
 	SKSE::Init(a_skse);
+	Random::bind(Random::Stream::kMain);
+	DDR::Settings::Load();
 
 	const auto msging = SKSE::GetMessagingInterface();
 	if (!msging->RegisterListener(SKSEMessageHandler)) {
 		logger::critical("Failed to register Listener");
 		return false;
 	}
+	// other plugins request the native interface with a message addressed to this plugin
+	if (!msging->RegisterListener(nullptr, DDR::API::HandleMessage)) {
+		logger::error("Failed to register interface listener, the native interface is unavailable");
+	}
 
 	const auto papyrus = SKSE::GetPapyrusInterface();
 	papyrus->Register(DDR::Papyrus::RegisterFunctions);
@@ -0,0 +1,169 @@
+// Checks the generator behind Random: seeded streams replay independently of thread scheduling, and draws are uniform
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Util/Random.h"
+
+namespace
+{
+	int failures = 0;
+
+	void Check(bool a_condition, const char* a_what)
+	{
+		if (!a_condition) {
+			std::printf("FAILED: %s\n", a_what);
+			failures++;
+		}
+	}
+
+	std::vector<int> DrawOnThread(std::optional<Random::Stream> a_stream, std::uint64_t a_index, size_t a_count)
+	{
+		std::vector<int> ret{};
+		std::thread{ [&] {
+			if (a_stream) {
+				Random::bind(*a_stream, a_index);
+			}
+			for (size_t i = 0; i < a_count; i++) {
+				ret.push_back(Random::draw<int>(0, 1'000'000));
+			}
+		} }.join();
+		return ret;
+	}
+
+	void TestReplay()
+	{
+		Random::seed(42);
+		const auto first = DrawOnThread(Random::Stream::kWorker, 0, 64);
+		const auto second = DrawOnThread(Random::Stream::kWorker, 1, 64);
+		// the same roles, first drawing in the opposite order
+		Random::seed(42);
+		const auto secondAgain = DrawOnThread(Random::Stream::kWorker, 1, 64);
+		const auto firstAgain = DrawOnThread(Random::Stream::kWorker, 0, 64);
+		Check(first == firstAgain && second == secondAgain, "a bound thread replays its draws regardless of scheduling order");
+		Check(first != second, "different roles draw different streams");
+
+		// threads which never bind are numbered from kUnbound in the order of their first draw, which replays as long as that order does
+		Random::seed(42);
+		const auto unbound = DrawOnThread(std::nullopt, 0, 64);
+		const auto unboundNext = DrawOnThread(std::nullopt, 0, 64);
+		Random::seed(42);
+		const auto unboundAgain = DrawOnThread(std::nullopt, 0, 64);
+		const auto unboundNextAgain = DrawOnThread(std::nullopt, 0, 64);
+		Check(unbound == DrawOnThread(Random::Stream::kUnbound, 0, 64), "the first unbound thread draws the kUnbound stream");
+		Check(unbound == unboundAgain && unboundNext == unboundNextAgain, "unbound threads replay their draws in the same order");
+		Check(unbound != unboundNext && unbound != first, "unbound threads draw streams of their own");
+
+		Random::seed(7);
+		const auto reseeded = DrawOnThread(Random::Stream::kWorker, 0, 64);
+		Check(reseeded != first, "a different seed draws a different stream");
+	}
+
+	void TestRange()
+	{
+		std::thread{ [] {
+			Random::bind(Random::Stream::kWorker, 2);
+			bool inRange = true;
+			std::array<bool, 5> seen{};
+			for (int i = 0; i < 10'000; i++) {
+				const auto value = Random::draw<int>(-2, 2);
+				inRange &= value >= -2 && value <= 2;
+				if (value >= -2 && value <= 2) {
+					seen[static_cast<size_t>(value + 2)] = true;
+				}
+			}
+			Check(inRange, "integer draws stay within both bounds");
+			Check(std::ranges::all_of(seen, std::identity{}), "integer draws reach both bounds");
+
+			bool singleValue = true;
+			for (int i = 0; i < 100; i++) {
+				singleValue &= Random::draw<std::uint64_t>(5, 5) == 5;
+			}
+			Check(singleValue, "a range of one value always draws it");
+
+			bool floatInRange = true;
+			for (int i = 0; i < 10'000; i++) {
+				const auto value = Random::draw<float>(0.25f, 0.75f);
+				floatInRange &= value >= 0.25f && value < 0.75f;
+			}
+			Check(floatInRange, "real draws stay within their half-open range");
+
+			bool hex = true;
+			for (int i = 0; i < 1'000; i++) {
+				const auto uuid = Random::generateUUID();
+				for (size_t c = 0; c < uuid.size(); c++) {
+					const bool dash = c == 8 || c == 13 || c == 18 || c == 23;
+					hex &= dash ? uuid[c] == '-' : std::string_view{ "0123456789abcdef" }.contains(uuid[c]);
+				}
+			}
+			Check(hex, "uuids only use lowercase hex digits");
+		} }.join();
+	}
+
+	void TestUniformity()
+	{
+		// chi-squared goodness of fit over 16 buckets, 15 degrees of freedom
+		constexpr size_t BUCKETS = 16;
+		constexpr size_t DRAWS = 160'000;
+		std::array<size_t, BUCKETS> counts{};
+		Xoshiro256 eng{ 7 };
+		for (size_t i = 0; i < DRAWS; i++) {
+			counts[eng() >> 60]++;
+		}
+		constexpr double expected = static_cast<double>(DRAWS) / BUCKETS;
+		double chi = 0.0;
+		for (const auto count : counts) {
+			const auto diff = static_cast<double>(count) - expected;
+			chi += diff * diff / expected;
+		}
+		// critical value at p = 0.001
+		Check(chi < 37.7, "upper bits are uniformly distributed");
+
+		// every bit is set in about half of the outputs
+		std::array<size_t, 64> bits{};
+		for (size_t i = 0; i < DRAWS; i++) {
+			const auto value = eng();
+			for (size_t b = 0; b < bits.size(); b++) {
+				bits[b] += (value >> b) & 1;
+			}
+		}
+		Check(std::ranges::all_of(bits, [](size_t n) { return n > DRAWS * 49 / 100 && n < DRAWS * 51 / 100; }), "every output bit is balanced");
+
+		// the same fit through the public interface, on a bound stream of a seeded run
+		Random::seed(42);
+		std::array<size_t, BUCKETS> drawn{};
+		std::thread{ [&] {
+			Random::bind(Random::Stream::kWorker, 3);
+			for (size_t i = 0; i < DRAWS; i++) {
+				drawn[Random::draw<size_t>(0, BUCKETS - 1)]++;
+			}
+		} }.join();
+		double drawnChi = 0.0;
+		for (const auto count : drawn) {
+			const auto diff = static_cast<double>(count) - expected;
+			drawnChi += diff * diff / expected;
+		}
+		Check(drawnChi < 37.7, "draws are uniformly distributed over their range");
+	}
+}
+
+int main()
+{
+	TestReplay();
+	TestRange();
+	TestUniformity();
+	if (failures == 0) {
+		std::printf("All Random checks passed\n");
+	}
+	return failures == 0 ? 0 : 1;
+}
@@ -16,6 +16,12 @@ option("copy_to_papyrus")
     set_description("Copy finished build to Papyrus SKSE folder")
 option_end()
 
+option("lua_ffi")
+    set_default(false)
+    set_description("Bind numeric Lua helpers through the LuaJIT FFI instead of sol2")
+    add_defines("DDR_LUA_FFI")
+option_end()
+
 -- Dependencies & Includes
 -- https://github.com/xmake-io/xmake-repo/tree/dev
 add_requires("yaml-cpp", "sol2", "frozen", "magic_enum")
@@ -33,6 +39,51 @@ target("detours")
     set_installdir("build/detours")
 target_end()
 
+target("RandomTest")
+    set_kind("binary")
+    set_default(false)
+    add_files("tests/RandomTest.cpp")
+    add_includedirs("src")
+    add_tests("default")
+target_end()
+
+-- Benchmarks, built on demand with `xmake build -g benchmarks` and run with `xmake run <name>`
+-- Each links only the plugin sources it measures, none of them calls into the game
+local CONDITION_SOURCES = { "src/Dialogue/Conditions/*.cpp", "src/Stats.cpp" }
+local LOADER_SOURCES = {
+    "src/Dialogue/ReplacementFile.cpp", "src/Dialogue/TopicInfo.cpp", "src/Dialogue/Topic.cpp",
+    "src/Dialogue/TextReplacement.cpp", "src/Dialogue/Placeholders.cpp"
+}
+
+local function benchmark(name, ...)
+    target(name)
+        set_kind("binary")
+        set_default(false)
+        set_group("benchmarks")
+        add_packages("yaml-cpp", "luajit", "sol2", "frozen", "magic_enum")
+        add_deps("commonlibsse-ng", "detours")
+        add_includedirs("src", "lib/detours/src")
+        set_pcxxheader("src/PCH.h")
+        add_files(...)
+    target_end()
+end
+
+benchmark("IndexScanBench", "bench/IndexScanBench.cpp", CONDITION_SOURCES)
+benchmark("ConditionBench", "bench/ConditionBench.cpp", CONDITION_SOURCES)
+benchmark("ParseBench", "bench/ParseBench.cpp")
+benchmark("LoaderBench", "bench/LoaderBench.cpp", CONDITION_SOURCES, LOADER_SOURCES)
+
+-- These only use header-only parts of the plugin and need none of its dependencies
+for _, name in ipairs({ "RandomBench", "TempTopicBench" }) do
+    target(name)
+        set_kind("binary")
+        set_default(false)
+        set_group("benchmarks")
+        add_files("bench/" .. name .. ".cpp")
+        add_includedirs("src")
+    target_end()
+end
+
 -- policies
 set_policy("package.requires_lock", true)
 
@@ -57,6 +108,7 @@ set_config("skyrim_vr", true)
 target(PROJECT_NAME)
     -- Dependencies
     add_packages("yaml-cpp", "luajit", "sol2", "frozen", "magic_enum")
+    add_options("lua_ffi")
     add_deps("detours")
     add_includedirs("lib/detours/src")
 